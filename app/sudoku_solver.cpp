@@ -1,12 +1,210 @@
 #include "sudoku/sudoku.hpp"
+#include "sudoku/batch.hpp"
+#include "sudoku/binary.hpp"
+#include "sudoku/generator.hpp"
+#include "sudoku/loader.hpp"
+#include "sudoku/parallel.hpp"
+#include "sudoku/service.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <signal.h>
+#endif
 
 using namespace std;
 using namespace sudoku;
 
+//Reads, solves, and prints the first puzzle in input on a grid of BoxSize x BoxSize boxes
+template <int BoxSize>
+int solveOne(ifstream& input, const SolveMethod& solver, const bool& unique, const bool& split, const unsigned int& splitThreads,
+    const bool& showStats){
+    BasicSudoku<BoxSize> sudoku(input, solver);
+    
+    if (!sudoku.isLogical()){
+        printf("Error: Sudoku is not logical\n");
+        sudoku.printGrid();
+        return 0;
+    }
+    if (unique){
+        switch (sudoku.countSolutions(2)){
+            case 0:
+                printf("Sudoku has no solution\n");
+                break;
+            case 1:
+                printf("Sudoku has a unique solution\n");
+                break;
+            default:
+                printf("Sudoku has more than one solution\n");
+        }
+    }
+
+    //solve Sudoku
+    bool solved = false;
+    if (split){
+        solved = sudoku.solveParallel(splitThreads == 0 ? defaultWorkers() : splitThreads);
+    }
+    else{
+        solved = sudoku.solve();
+    }
+    if (solved){
+        printf("Sudoku solved!\n");
+    }
+    else if (solver == RULES){
+        printf("Sudoku could not be solved with rules alone\n");
+    }
+    else{
+        printf("Sudoku is not solvable\n");
+    }
+
+    sudoku.printGrid();
+    if (showStats){
+        sudoku.getStats().print();
+    }
+    return 1;
+}
+
+//Solves every puzzle from source and writes one line per puzzle in input order, solved grid or what was left of it
+//Source is anything solveBatch takes: a stream, a mapped file's view, or a BinaryReader
+//A binary record that was skipped gets an empty line, so line k is always record k
+template <typename Source>
+BatchResult solveLines(Source& source, const SolveMethod& solver, const unsigned int& threads, LineWriter& out){
+    size_t written = 0;
+    auto skipTo = [&written, &out] (const size_t& i){
+        for (; written < i; ++written){
+            out.write("");
+        }
+        ++written;
+    };
+    if (threads == 1){
+        string line;
+        return solveBatch(source, solver, [&line, &out, &skipTo] (size_t i, const Sudoku& sudoku, bool){
+            skipTo(i);
+            line.clear();
+            sudoku.appendLine(line);
+            out.write(line);
+        });
+    }
+    return solveBatchParallel(source, solver, threads == 0 ? defaultWorkers() : threads, [&out, &skipTo] (size_t i, string_view line, bool){
+        skipTo(i);
+        out.write(line);
+    });
+}
+
+//Writes every puzzle in input to output, text puzzles become a binary file and a binary file becomes text lines
+int convert(const MappedFile& input, const string& output){
+    ofstream out(output, ios::binary);
+    if (!out.is_open()){
+        printf("Error: could not create file %s\n", output.c_str());
+        return 0;
+    }
+    size_t count = 0;
+    if (BinaryReader::isBinary(input.view())){
+        BinaryReader reader(input.view());
+        Board board;
+        string line;
+        while (reader.next(board)){
+            line.clear();
+            appendBoardLine(board, line);
+            line.push_back('\n');
+            out.write(line.data(), line.size());
+            ++count;
+        }
+    }
+    else{
+        BinaryWriter writer(out);
+        PuzzleScanner scanner(input.view());
+        string_view record;
+        while (scanner.next(record)){
+            writer.add(record);
+        }
+        if (!writer.finish()){
+            printf("Error: could not write %s\n", output.c_str());
+            return 0;
+        }
+        count = writer.getCount();
+    }
+    printf("Wrote %zu puzzles to %s\n", count, output.c_str());
+    return 1;
+}
+
+//Makes count puzzles and writes them to stdout one per line, totals go to stderr
+int generate(const size_t& count, const Difficulty& difficulty, const uint64_t& seed, const unsigned int& threads){
+    auto start = chrono::steady_clock::now();
+    vector<Board> puzzles = generatePuzzles(count, difficulty, seed, threads);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t made = 0;
+    {
+        LineWriter out(stdout);
+        string line;
+        for (const Board& puzzle : puzzles){
+            //Puzzles that could not be made have no squares filled in
+            if (puzzle.cells == Board().cells){
+                continue;
+            }
+            line.clear();
+            appendBoardLine(puzzle, line);
+            out.write(line);
+            ++made;
+        }
+    }
+    fprintf(stderr, "Generated %zu of %zu puzzles\n", made, count);
+    fprintf(stderr, "Time: %.3f s (%.1f puzzles/s)\n", seconds, made / seconds);
+    return made == count ? 1 : 0;
+}
+
+//Answers requests on address until SIGINT or SIGTERM, see answerRequest for the protocol
+int serve(const string& address, const SolveMethod& solver, const unsigned int& threads){
+#if defined(__unix__) || defined(__APPLE__)
+    //Blocked before any thread starts so they all leave the stop signals to sigwait below
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+#endif
+    ServiceConfig config;
+    config.method = solver;
+    config.workers = threads;
+    SolverService service(config);
+    if (!service.start(address)){
+        return 0;
+    }
+    if (service.getPort() != 0){
+        printf("Listening on localhost port %u\n", service.getPort());
+    }
+    else{
+        printf("Listening on %s\n", address.c_str());
+    }
+    fflush(stdout);
+#if defined(__unix__) || defined(__APPLE__)
+    int received = 0;
+    sigwait(&stopSignals, &received);
+#endif
+    service.stop();
+    printf("Answered %zu requests\n", service.getAnswered());
+    return 1;
+}
+
 int main(int argc, char *argv[]){
 
     string filename = "sudoku.txt";
     SolveMethod solver = BACKTRACK;
+    bool batch = false;
+    bool stream = false;
+    unsigned int threads = 1;
+    bool split = false;
+    bool unique = false;
+    bool showStats = false;
+    unsigned int splitThreads = 0;
+    string output;
+    size_t generateCount = 0;
+    uint64_t seed = 0;
+    Difficulty difficulty = MEDIUM;
+    int boxSize = box_size;
+    string listen;
 
     for (int i = 0; i < argc; ++i){
         string option = argv[i];
@@ -19,15 +217,110 @@ int main(int argc, char *argv[]){
         if (option == "-r"){
             solver = RULES;
         }
+        if (option == "-m"){
+            solver = HYBRID;
+        }
+        if (option == "-d"){
+            solver = DLX;
+        }
+        if (option == "-a"){
+            batch = true;
+        }
+        if (option == "-s"){
+            stream = true;
+        }
+        if (option == "-u"){
+            unique = true;
+        }
+        if (option == "-v"){
+            showStats = true;
+        }
+        if (option == "-t" && i + 1 < argc){
+            splitThreads = stoi(argv[i+1]);
+            split = true;
+        }
+        if (option == "-j" && i + 1 < argc){
+            threads = stoi(argv[i+1]);
+            batch = true;
+        }
+        if (option == "-o" && i + 1 < argc){
+            output = argv[i+1];
+        }
+        if (option == "-g" && i + 1 < argc){
+            generateCount = stoull(argv[i+1]);
+        }
+        if (option == "-k" && i + 1 < argc){
+            seed = stoull(argv[i+1]);
+        }
+        if (option == "-e" && i + 1 < argc){
+            const string names[] = {"easy", "medium", "hard", "expert"};
+            auto name = find(begin(names), end(names), string(argv[i+1]));
+            if (name == end(names)){
+                printf("Error: unknown difficulty %s, use easy, medium, hard, or expert\n", argv[i+1]);
+                return 0;
+            }
+            difficulty = Difficulty(name - begin(names));
+        }
+        if (option == "-l" && i + 1 < argc){
+            listen = argv[i+1];
+        }
+        if (option == "-n" && i + 1 < argc){
+            boxSize = stoi(argv[i+1]);
+        }
         if (option == "-h"){
-            printf("Usage: %s [-f filename] [-b] [-r]\n", argv[0]);
+            printf("Usage: %s [-f filename] [-b] [-r] [-m] [-d] [-a] [-s] [-j threads] [-t threads] [-u] [-v] [-n box size] [-o output] [-g count] [-k seed] [-e difficulty] [-l address]\n", argv[0]);
             printf("-f filename: specify a file to read in. Default is \"sudoku.txt\"\n");
             printf("-b: use backtracking\n");
-            printf("-r: use rules (not implemented yet)\n");
+            printf("-r: use rules only, stops if the puzzle needs guessing\n");
+            printf("-m: use backtracking on the square with fewest possibles, filling singles after every guess\n");
+            printf("-d: use exact cover with dancing links\n");
+            printf("-a: solve all puzzles in the file, titled grids or one puzzle per line\n");
+            printf("-s: read puzzles from stdin and write one solution line each to stdout, totals go to stderr\n");
+            printf("-j threads: solve all puzzles in the file on this many threads, 0 for one per core\n");
+            printf("-t threads: split the search for one hard puzzle across this many threads, 0 for one per core\n");
+            printf("-u: check whether the puzzle has exactly one solution before solving\n");
+            printf("-v: print solve stats: nodes, backtracks, deductions by rule, and where the time went\n");
+            printf("-n box size: 2 for 4x4, 3 for 9x9 (default), 4 for 16x16, 5 for 25x25. Values past 9 are letters\n");
+            printf("-g count: generate this many puzzles with exactly one solution to stdout, on -j threads\n");
+            printf("-k seed: seed for -g, the same seed always gives the same puzzles. Default is 0\n");
+            printf("-e difficulty: easy (singles), medium (intersections), hard (pairs and triples), or expert (guessing) for -g. Default is medium\n");
+            printf("-l address: answer puzzle requests on a Unix socket path or tcp:<port> on localhost until stopped, on -j threads\n");
+            printf("-o output: convert the puzzles in the file to binary, or a binary file back to text lines, and stop\n");
             return 1;
         }
     }
 
+    if (boxSize < 2 || boxSize > max_box_size){
+        printf("Error: box size %d is not supported, use 2 to %d\n", boxSize, max_box_size);
+        return 0;
+    }
+    if ((batch || stream || generateCount > 0 || !output.empty() || !listen.empty()) && boxSize != box_size){
+        printf("Error: batch solving, generating, converting, and the service only support 9x9 puzzles\n");
+        return 0;
+    }
+
+    if (!listen.empty()){
+        return serve(listen, solver, threads);
+    }
+
+    if (generateCount > 0){
+        return generate(generateCount, difficulty, seed, threads);
+    }
+
+    //Nothing but solution lines goes to stdout, so the solver can sit in the middle of a pipeline
+    //The reader holds one puzzle and the parallel batch one window, so memory stays the same however much comes in
+    if (stream){
+        ios::sync_with_stdio(false);
+        BatchResult result;
+        {
+            LineWriter out(stdout);
+            result = solveLines(cin, solver, threads, out);
+        }
+        fprintf(stderr, "Solved %zu of %zu puzzles, %zu failed\n", result.solved, result.total(), result.failed);
+        fprintf(stderr, "Time: %.3f s (%.1f puzzles/s)\n", result.seconds, result.puzzlesPerSecond());
+        return 1;
+    }
+
     //read Sudoku
     ifstream input;
     printf("Reading in %s\n", filename.c_str());
@@ -36,21 +329,52 @@ int main(int argc, char *argv[]){
         printf("Error: could not open file %s\n", filename.c_str());
         return 0;
     }
-    Sudoku sudoku(input, solver);
-    
-    if (!sudoku.isLogical()){
-        printf("Error: Sudoku is not logical\n");
-        sudoku.printGrid();
-        return 0;
+
+    //Puzzles are loaded straight out of the mapped file, the stream is only used if mapping fails
+    MappedFile mapped(filename);
+    if (!output.empty()){
+        if (!mapped.isOpen()){
+            printf("Error: could not map file %s\n", filename.c_str());
+            return 0;
+        }
+        return convert(mapped, output);
     }
-    //solve Sudoku
-    if (sudoku.solve()){
-        printf("Sudoku solved!\n");
+    //Binary files are always solved as a batch
+    bool binary = mapped.isOpen() && BinaryReader::isBinary(mapped.view());
+    BinaryReader reader(binary ? mapped.view() : string_view());
+    if (binary && !reader.isValid()){
+        printf("Error: %s is not a valid 9x9 binary puzzle file\n", filename.c_str());
+        return 0;
     }
-    else{
-        printf("Sudoku is not solvable\n");
+
+    if (batch || binary){
+        BatchResult result;
+        {
+            LineWriter out(stdout);
+            if (binary){
+                result = solveLines(reader, solver, threads, out);
+            }
+            else if (mapped.isOpen()){
+                string_view view = mapped.view();
+                result = solveLines(view, solver, threads, out);
+            }
+            else{
+                result = solveLines(input, solver, threads, out);
+            }
+        }
+        printf("Solved %zu of %zu puzzles, %zu failed\n", result.solved, result.total(), result.failed);
+        printf("Time: %.3f s (%.1f puzzles/s)\n", result.seconds, result.puzzlesPerSecond());
+        return 1;
     }
 
-    sudoku.printGrid();
-    return 1;
+    switch (boxSize){
+        case 2:
+            return solveOne<2>(input, solver, unique, split, splitThreads, showStats);
+        case 4:
+            return solveOne<4>(input, solver, unique, split, splitThreads, showStats);
+        case 5:
+            return solveOne<5>(input, solver, unique, split, splitThreads, showStats);
+        default:
+            return solveOne<3>(input, solver, unique, split, splitThreads, showStats);
+    }
 }
@@ -0,0 +1,240 @@
+#include "benchmark/benchmark.h"
+#include "sudoku/batch.hpp"
+#include "sudoku/canonical.hpp"
+#include "sudoku/loader.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sudoku;
+
+namespace {
+
+    //One graded set of puzzles, read once and loaded once so the timed loops only do the work being measured
+    struct Corpus {
+        string name;
+        string path;
+        vector<string> puzzles;
+        vector<Sudoku> loaded;
+        //Solved grids from DLX, empty for puzzles with no solution
+        vector<Board> solutions;
+    };
+
+    //easy is solvable by rules alone, hard needs guessing, minimal has the fewest clues,
+    //and unsat reads in fine but has no solution
+    const char* corpus_names[] = {"easy", "hard", "minimal", "unsat"};
+
+    struct Method {
+        const char* name;
+        SolveMethod method;
+    };
+
+    const Method methods[] = {{"BACKTRACK", BACKTRACK}, {"RULES", RULES}, {"HYBRID", HYBRID}, {"DLX", DLX}};
+
+    bool readCorpus(Corpus& corpus){
+        ifstream input(corpus.path);
+        if (!input.is_open()){
+            printf("Error: Failed to open %s\n", corpus.path.c_str());
+            return false;
+        }
+        PuzzleReader reader(input);
+        string puzzle;
+        while (reader.next(puzzle)){
+            Sudoku s1;
+            if (!s1.load(puzzle)){
+                printf("Error: %s puzzle %zu not logical\n", corpus.name.c_str(), reader.getCount());
+                return false;
+            }
+            Sudoku solved = s1;
+            solved.setSolverType(DLX);
+            corpus.solutions.push_back(solved.solve() ? solved.getBoard() : Board());
+            corpus.puzzles.push_back(puzzle);
+            corpus.loaded.push_back(s1);
+        }
+        if (corpus.puzzles.empty()){
+            printf("Error: No puzzles in %s\n", corpus.path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    void setItems(benchmark::State& state, const Corpus& corpus){
+        state.SetItemsProcessed(state.iterations()*corpus.puzzles.size());
+    }
+
+    //Reading a puzzle string into a reused Sudoku, possibles included
+    void benchLoad(benchmark::State& state, const Corpus* corpus){
+        Sudoku s1;
+        for (auto _ : state){
+            for (const string& puzzle : corpus->puzzles){
+                benchmark::DoNotOptimize(s1.load(puzzle));
+            }
+        }
+        setItems(state, *corpus);
+    }
+
+    //The whole corpus file through ifstream and PuzzleReader, each puzzle loaded
+    void benchRead(benchmark::State& state, const Corpus* corpus){
+        Sudoku s1;
+        string puzzle;
+        for (auto _ : state){
+            ifstream input(corpus->path);
+            PuzzleReader reader(input);
+            while (reader.next(puzzle)){
+                benchmark::DoNotOptimize(s1.load(puzzle));
+            }
+        }
+        setItems(state, *corpus);
+    }
+
+    //The same through a MappedFile and PuzzleScanner, loading straight from the mapped bytes
+    void benchScan(benchmark::State& state, const Corpus* corpus){
+        Sudoku s1;
+        string_view record;
+        for (auto _ : state){
+            MappedFile mapped(corpus->path);
+            PuzzleScanner scanner(mapped.view());
+            while (scanner.next(record)){
+                benchmark::DoNotOptimize(s1.load(record));
+            }
+        }
+        setItems(state, *corpus);
+    }
+
+    //Opening the corpus file and constructing a Sudoku from its first puzzle
+    void benchConstruct(benchmark::State& state, const Corpus* corpus){
+        for (auto _ : state){
+            ifstream input(corpus->path);
+            Sudoku s1(input);
+            benchmark::DoNotOptimize(s1.isLogical());
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    //Every given checked as placed and every blank checked against each value
+    void benchCheckSquare(benchmark::State& state, const Corpus* corpus){
+        vector<Sudoku> sudokus = corpus->loaded;
+        for (auto _ : state){
+            for (Sudoku& s1 : sudokus){
+                const Board board = s1.getBoard();
+                for (uint8_t i = 0; i < grid_size; ++i){
+                    if (!board[i].isBlank()){
+                        benchmark::DoNotOptimize(s1.checkSquare(i));
+                        continue;
+                    }
+                    for (uint8_t val = 1; val <= number_of_element_values; ++val){
+                        benchmark::DoNotOptimize(s1.checkSquare(i, val));
+                    }
+                }
+            }
+        }
+        setItems(state, *corpus);
+    }
+
+    //Fills every blank with its solved value, starting from a fresh copy of each puzzle
+    void benchAssignSquare(benchmark::State& state, const Corpus* corpus){
+        for (auto _ : state){
+            for (size_t k = 0; k < corpus->loaded.size(); ++k){
+                Sudoku s1 = corpus->loaded[k];
+                const Board start = s1.getBoard();
+                const Board& solution = corpus->solutions[k];
+                for (uint8_t i = 0; i < grid_size; ++i){
+                    if (start[i].isBlank()){
+                        benchmark::DoNotOptimize(s1.assignSquare(i, solution[i].getElement()));
+                    }
+                }
+                benchmark::DoNotOptimize(s1);
+            }
+        }
+        setItems(state, *corpus);
+    }
+
+    //Canonical key of every loaded puzzle
+    void benchCanonicalize(benchmark::State& state, const Corpus* corpus){
+        for (auto _ : state){
+            for (const Sudoku& loaded : corpus->loaded){
+                benchmark::DoNotOptimize(canonicalize(loaded.getBoard()));
+            }
+        }
+        setItems(state, *corpus);
+    }
+
+    //Every puzzle through a SolutionCache that has already seen the corpus, so each solve is a hit
+    void benchCachedSolve(benchmark::State& state, const Corpus* corpus){
+        SolutionCache cache;
+        Board solution;
+        for (const Sudoku& loaded : corpus->loaded){
+            cache.solve(loaded.getBoard(), solution);
+        }
+        for (auto _ : state){
+            for (const Sudoku& loaded : corpus->loaded){
+                benchmark::DoNotOptimize(cache.solve(loaded.getBoard(), solution));
+            }
+        }
+        setItems(state, *corpus);
+    }
+
+    //Solves a copy of every loaded puzzle, nodes is the steps each solver reports
+    void benchSolve(benchmark::State& state, const Corpus* corpus, SolveMethod method){
+        uint64_t nodes = 0;
+        uint64_t solved = 0;
+        for (auto _ : state){
+            for (const Sudoku& loaded : corpus->loaded){
+                Sudoku s1 = loaded;
+                s1.setSolverType(method);
+                solved += s1.solve();
+                nodes += s1.getSteps();
+            }
+        }
+        state.counters["nodes"] = benchmark::Counter(double(nodes), benchmark::Counter::kIsRate);
+        state.counters["solved"] = benchmark::Counter(double(solved), benchmark::Counter::kAvgIterations);
+        setItems(state, *corpus);
+    }
+
+}
+
+int main(int argc, char** argv){
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)){
+        return 1;
+    }
+
+    //Benchmarks hold pointers into corpora, so it is filled before any are registered
+    vector<Corpus> corpora;
+    for (const char* name : corpus_names){
+        Corpus corpus;
+        corpus.name = name;
+        corpus.path = string(SUDOKU_BENCH_CORPUS_DIR) + "/" + name + ".txt";
+        if (!readCorpus(corpus)){
+            return 1;
+        }
+        corpora.push_back(std::move(corpus));
+    }
+
+    benchmark::RegisterBenchmark("Construct/file", benchConstruct, &corpora[0]);
+    for (const Corpus& corpus : corpora){
+        benchmark::RegisterBenchmark(("Load/" + corpus.name).c_str(), benchLoad, &corpus);
+        benchmark::RegisterBenchmark(("Read/" + corpus.name).c_str(), benchRead, &corpus);
+        benchmark::RegisterBenchmark(("Scan/" + corpus.name).c_str(), benchScan, &corpus);
+        benchmark::RegisterBenchmark(("CheckSquare/" + corpus.name).c_str(), benchCheckSquare, &corpus);
+        benchmark::RegisterBenchmark(("Canonicalize/" + corpus.name).c_str(), benchCanonicalize, &corpus);
+        benchmark::RegisterBenchmark(("CachedSolve/" + corpus.name).c_str(), benchCachedSolve, &corpus);
+        //Unsolvable puzzles have no values to assign
+        if (corpus.name != "unsat"){
+            benchmark::RegisterBenchmark(("AssignSquare/" + corpus.name).c_str(), benchAssignSquare, &corpus);
+        }
+    }
+    for (const Method& method : methods){
+        for (const Corpus& corpus : corpora){
+            benchmark::RegisterBenchmark(("Solve/" + string(method.name) + "/" + corpus.name).c_str(), benchSolve, &corpus, method.method)
+                ->Unit(benchmark::kMillisecond);
+        }
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
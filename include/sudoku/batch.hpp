@@ -0,0 +1,97 @@
+#ifndef SUDOKU_BATCH_HPP
+#define SUDOKU_BATCH_HPP
+
+#include "sudoku/sudoku.hpp"
+#include "sudoku/binary.hpp"
+
+#include <cstdio>
+#include <istream>
+#include <string>
+#include <functional>
+#include <string_view>
+
+namespace sudoku{
+
+    //PuzzleReader pulls puzzles one at a time out of a stream holding any number of them
+    //Two layouts are understood, and can be mixed in one stream:
+    // - grids of number_of_element_values rows with a title or decoration in between (see sudoku.txt)
+    // - one puzzle per line, grid_size squares with '.', '0', or '-' for blanks
+    //Lines that are neither a grid row nor a whole puzzle are skipped
+    class PuzzleReader {
+        public:
+        explicit PuzzleReader(std::istream& in) : in(in) {}
+
+        //Fills puzzle with the next grid_size squares, '-' for blanks. Returns false at end of input
+        bool next(std::string& puzzle);
+        //Puzzles returned by next so far
+        std::size_t getCount() const { return count; }
+
+        private:
+        std::istream& in;
+        std::string line;
+        std::size_t count = 0;
+    };
+
+    struct BatchResult {
+        std::size_t solved = 0;
+        std::size_t failed = 0;
+        double seconds = 0;
+
+        std::size_t total() const { return solved + failed; }
+        double puzzlesPerSecond() const { return seconds > 0 ? total() / seconds : 0; }
+    };
+
+    //Called after each puzzle with its position in the input, the solver, and whether it was solved
+    //The position is the puzzle's count in text and its record number in a binary file, skipped records included
+    using BatchCallback = std::function<void(std::size_t, const Sudoku&, bool)>;
+
+    //Solves every puzzle in the stream with one Sudoku reused for all of them
+    //Puzzles that are not logical count as failed
+    BatchResult solveBatch(std::istream& in, const SolveMethod& solver, const BatchCallback& onResult = nullptr);
+    //Same for text already in memory, such as a MappedFile. Puzzles are loaded straight from data with no copies
+    BatchResult solveBatch(std::string_view data, const SolveMethod& solver, const BatchCallback& onResult = nullptr);
+    //Same for the puzzles left in a binary file, starting where reader is
+    BatchResult solveBatch(BinaryReader& reader, const SolveMethod& solver, const BatchCallback& onResult = nullptr);
+
+    //Called in input order with each puzzle's position, its grid after solving as one line, and whether it was solved
+    using LineCallback = std::function<void(std::size_t, std::string_view, bool)>;
+
+    inline constexpr auto batch_window_per_worker = 1024; //Puzzles held in memory per worker thread
+    inline constexpr auto batch_claim = 32; //Puzzles a worker takes at a time, so the lock isn't taken per puzzle
+
+    //Solves every puzzle in the stream on threads workers, each taking the next unsolved puzzle as it frees up
+    //At most a window of puzzles is held at once so memory stays bounded, and results are handed to onResult
+    //in input order on the calling thread no matter which worker finished first. Workers carry on past a slow
+    //puzzle until the window behind it is full. Every worker reuses one Sudoku
+    BatchResult solveBatchParallel(std::istream& in, const SolveMethod& solver, const unsigned int& threads,
+        const LineCallback& onResult = nullptr);
+    BatchResult solveBatchParallel(std::string_view data, const SolveMethod& solver, const unsigned int& threads,
+        const LineCallback& onResult = nullptr);
+    BatchResult solveBatchParallel(BinaryReader& reader, const SolveMethod& solver, const unsigned int& threads,
+        const LineCallback& onResult = nullptr);
+
+    inline constexpr auto stream_flush_bytes = 1 << 16; //Output held back before it is written out in one go
+
+    //Collects output lines and writes them out in large blocks instead of one printf per line or per square
+    //Memory stays at about flushBytes no matter how many lines go through
+    class LineWriter {
+        public:
+        explicit LineWriter(std::FILE* out, const std::size_t& flushBytes = stream_flush_bytes);
+        ~LineWriter() { flush(); }
+        LineWriter(const LineWriter&) = delete;
+        LineWriter& operator=(const LineWriter&) = delete;
+
+        //Adds line and a newline, writing the buffer out once it holds flushBytes
+        void write(std::string_view line);
+        //Writes out everything held so far, returns false if the write failed
+        bool flush();
+
+        private:
+        std::FILE* out;
+        std::size_t flushBytes;
+        std::string buffer;
+    };
+
+} //End namespace sudoku
+
+#endif //SUDOKU_BATCH_HPP
@@ -0,0 +1,88 @@
+#ifndef SUDOKU_BINARY_HPP
+#define SUDOKU_BINARY_HPP
+
+#include "sudoku/sudoku.hpp"
+
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace sudoku{
+
+    //Binary puzzle files hold fixed size records for 9x9 grids after a 16 byte header:
+    // - magic "SDKB", then one byte each for version, box size, and flags, one unused, and an 8 byte little endian record count
+    // - each record is one 4 bit value per square, 0 for blank, low nibble first
+    // - with binary_givens set, a bitmap of the given squares follows the values so solved grids keep their clues
+    //Records are all the same size, so puzzle k is found without reading the ones before it
+    inline constexpr char binary_magic[] = "SDKB";
+    inline constexpr uint8_t binary_version = 1;
+    inline constexpr uint8_t binary_givens = 1; //Flag for records with a givens bitmap
+    inline constexpr std::size_t binary_header_size = 16;
+    inline constexpr std::size_t packed_values_size = (grid_size + 1) / 2;
+    inline constexpr std::size_t packed_givens_size = (grid_size + 7) / 8;
+
+    //Packs the values of a board, and its given squares when givens is set, into out
+    void packBoard(const Board& board, uint8_t* out, const bool& givens);
+    //Packs a puzzle written with the same symbols as Sudoku::load, every value a given
+    //Returns false if puzzle does not hold grid_size squares
+    bool packPuzzle(std::string_view puzzle, uint8_t* out);
+    //Fills board with the values and given squares in a packed record, possibles are left empty
+    //Without givens every value is a given. Returns false if a value is out of range
+    bool unpackBoard(const uint8_t* in, Board& board, const bool& givens);
+    //Appends board as one line of grid_size symbols, '-' for blanks
+    void appendBoardLine(const Board& board, std::string& out);
+
+    //Writes a binary puzzle file one record at a time
+    //The header goes out first with no count, finish() goes back and fills it in, so out must be seekable
+    class BinaryWriter {
+        public:
+        explicit BinaryWriter(std::ostream& out, const bool& givens = false);
+
+        //Returns false if puzzle is not a whole grid, nothing is written then
+        bool add(std::string_view puzzle);
+        void add(const Board& board);
+        //Writes the record count into the header, returns false if anything failed to write
+        bool finish();
+        std::size_t getCount() const { return count; }
+
+        private:
+        std::ostream& out;
+        std::streampos start;
+        bool givens;
+        std::size_t count = 0;
+        std::string record;
+    };
+
+    //Reads a binary puzzle file held in memory, such as a MappedFile, without copying it
+    class BinaryReader {
+        public:
+        explicit BinaryReader(std::string_view data);
+
+        //False if data does not start with a 9x9 header or is shorter than the records it claims
+        bool isValid() const { return valid; }
+        std::size_t size() const { return count; }
+        bool hasGivens() const { return givens; }
+
+        //Puzzle k, see unpackBoard. Returns false if k is past the end
+        bool get(const std::size_t& k, Board& board) const;
+        //Next puzzle in file order, so a reader can be used like a PuzzleScanner. Returns false at the end
+        //A record with a value out of range is reported and skipped
+        bool next(Board& board);
+        //Records gone through by next so far, skipped ones included, so the last puzzle came from record getCount() - 1
+        std::size_t getCount() const { return position; }
+
+        //True if data starts with the binary magic
+        static bool isBinary(std::string_view data);
+
+        private:
+        std::string_view data;
+        std::size_t count = 0;
+        std::size_t recordSize = 0;
+        std::size_t position = 0;
+        bool givens = false;
+        bool valid = false;
+    };
+
+} //End namespace sudoku
+
+#endif //SUDOKU_BINARY_HPP
@@ -0,0 +1,96 @@
+#ifndef SUDOKU_CANONICAL_HPP
+#define SUDOKU_CANONICAL_HPP
+
+#include "sudoku/sudoku.hpp"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace sudoku{
+
+    inline constexpr std::size_t canonical_state_cap = 1 << 14; //Tied orientations kept before the search gives up
+    //The first row of a solved grid ties in all 2*9*6^4 = 23328 orientations, so grids with no blanks get at least this
+    inline constexpr std::size_t canonical_solved_state_cap = 1 << 15;
+    inline constexpr std::size_t solution_cache_capacity = 1 << 16;
+
+    //Maps a 9x9 grid onto an equivalent one: optionally transposed, then rows and columns picked from the
+    //(transposed) grid, then the digits relabeled. Rows only move within their band and bands as a whole,
+    //same for columns and stacks, so every transform keeps a valid sudoku valid
+    struct Transform {
+        bool transpose = false;
+        std::array<uint8_t, number_of_element_values> rows{0, 1, 2, 3, 4, 5, 6, 7, 8};
+        std::array<uint8_t, number_of_element_values> cols{0, 1, 2, 3, 4, 5, 6, 7, 8};
+        //New value for each old value, 0 is the blank and stays 0
+        std::array<uint8_t, number_of_element_values + 1> relabel{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+        //Square of the original grid that lands on index
+        uint8_t sourceOf(const uint8_t& index) const {
+            uint8_t row = rows[rowOf(index)], col = cols[colOf(index)];
+            return transpose ? col*number_of_element_values + row : row*number_of_element_values + col;
+        }
+    };
+
+    //Every grid equivalent to a puzzle shares one key: the smallest string of values, '0' for blanks,
+    //over every transform, with digits numbered in order of first appearance
+    struct CanonicalForm {
+        std::string key;
+        //Takes the puzzle to the grid the key was read from
+        Transform transform;
+        //False if the search hit its state cap. The key is then only the puzzle relabeled, still a valid key
+        //for the puzzle but equivalent puzzles may get different ones
+        bool exact = false;
+    };
+
+    //Works out the canonical form with a search over orientations, row by row, keeping only the ones tied for
+    //the smallest prefix. Very symmetric grids can tie in more than stateCap orientations, see CanonicalForm::exact
+    //A grid with no blanks searches with at least canonical_solved_state_cap, enough for it to always be exact
+    CanonicalForm canonicalize(const Board& board, const std::size_t& stateCap = canonical_state_cap);
+    //Board with transform applied, givens kept and possibles left empty
+    Board applyTransform(const Board& board, const Transform& transform);
+    //Takes a transformed board back to the orientation and digits of the original
+    Board invertTransform(const Board& board, const Transform& transform);
+
+    //Least recently used cache of solutions, stored in canonical form so any puzzle equivalent to one already
+    //solved is a hit. Puzzles with no solution are cached as well
+    class SolutionCache {
+        public:
+        explicit SolutionCache(const std::size_t& capacity = solution_cache_capacity, const SolveMethod& solver = HYBRID);
+
+        //Solves puzzle into solution from the cache, or with the solver on a miss and keeps the result
+        //Returns false if the puzzle is not logical or has no solution
+        bool solve(const Board& puzzle, Board& solution);
+        //Same without solving on a miss, returns false if the puzzle was not found. Hits and misses count the same
+        bool find(const Board& puzzle, Board& solution, bool& solvable);
+
+        std::size_t size() const { return index.size(); }
+        std::size_t getHits() const { return hits; }
+        std::size_t getMisses() const { return misses; }
+        void clear();
+
+        //Writes every entry as a line of key and solution, least recently used first, so loading it back keeps the order
+        bool save(const std::string& path) const;
+        //Adds the entries in a file written by save, returns false if it could not be read
+        bool load(const std::string& path);
+
+        private:
+        //Canonical key and the solution in the same orientation, empty if there is none
+        using Entry = std::pair<std::string, std::string>;
+        std::list<Entry> entries; //Most recently used first
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        std::size_t capacity;
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        Sudoku sudoku;
+
+        //Looks key up and moves it to the front, nullptr if it is not cached
+        std::string* lookup(const std::string& key);
+        void insert(const std::string& key, std::string solution);
+        //Takes a stored solution back to the puzzle's orientation, returns false if it holds no solution
+        bool restore(const std::string& stored, const Board& puzzle, const Transform& transform, Board& solution) const;
+    };
+
+} //End namespace sudoku
+
+#endif //SUDOKU_CANONICAL_HPP
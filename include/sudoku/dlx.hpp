@@ -0,0 +1,83 @@
+#ifndef SUDOKU_DLX_HPP
+#define SUDOKU_DLX_HPP
+
+#include "sudoku/sudoku.hpp"
+
+#include <vector>
+#include <array>
+
+namespace sudoku{
+
+    inline constexpr auto dlx_constraints = 4; //Cell, row-value, column-value, and box-value
+    inline constexpr auto dlx_columns = dlx_constraints*grid_size;
+    inline constexpr auto dlx_rows = grid_size*number_of_element_values; //One row per square and value
+
+    //DancingLinks solves a grid as an exact cover problem with Knuth's Algorithm X
+    //All links live in one node pool allocated by the constructor, loading and solving never allocate
+    //load() starts over with a new grid, so one object can be kept and reused for any number of puzzles
+    template <int BoxSize>
+    class BasicDancingLinks {
+        public:
+        using traits = GridTraits<BoxSize>;
+        using Board = BasicBoard<BoxSize>;
+
+        static constexpr int number_of_element_values = traits::number_of_element_values;
+        static constexpr int grid_size = traits::grid_size;
+        static constexpr int columns = dlx_constraints*grid_size;
+        static constexpr int rows = grid_size*number_of_element_values;
+
+        BasicDancingLinks();
+
+        //Builds the matrix and covers the givens of grid, returns false if the givens conflict
+        bool load(const Board& grid);
+        bool solve();
+        //solve() that gives up once a limit is hit, see SolveLimits
+        SolveStatus solve(const SolveLimits& limits);
+        //Writes the solved values into the blank squares of grid, returns false if there is no solution
+        bool writeSolution(Board& grid) const;
+
+        unsigned int getSteps() const { return steps; }
+        //Rows picked and taken back again, and most rows picked past the givens, same as SolveStats
+        unsigned int getBacktracks() const { return backtracks; }
+        uint16_t getMaxDepth() const { return maxDepth; }
+
+        private:
+        struct Node {
+            uint16_t left, right, up, down;
+            uint16_t column;
+            uint16_t row;
+        };
+        static constexpr uint16_t root = 0;
+        static constexpr uint16_t first_row_node = columns + 1;
+        //25x25 needs 65001 nodes, just enough for 16 bit links
+        static_assert(first_row_node + rows*dlx_constraints <= UINT16_MAX + 1, "Node pool too large for 16 bit links");
+
+        std::vector<Node> nodes;
+        std::array<uint8_t, columns + 1> sizes{};
+        std::array<bool, columns + 1> covered{};
+        //Rows picked so far, givens first
+        std::array<uint16_t, grid_size> picked{};
+        uint16_t depth = 0;
+        uint16_t givens = 0;
+        bool solved = false;
+        unsigned int steps = 0;
+        unsigned int backtracks = 0;
+        uint16_t maxDepth = 0;
+        const SolveLimits* limits = nullptr;
+        SolveStatus stopped = SOLVED;
+
+        void cover(const uint16_t& column);
+        void uncover(const uint16_t& column);
+        bool search();
+    };
+
+    using DancingLinks = BasicDancingLinks<3>;
+
+    extern template class BasicDancingLinks<2>;
+    extern template class BasicDancingLinks<3>;
+    extern template class BasicDancingLinks<4>;
+    extern template class BasicDancingLinks<5>;
+
+} //End namespace sudoku
+
+#endif //SUDOKU_DLX_HPP
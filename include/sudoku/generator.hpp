@@ -0,0 +1,43 @@
+#ifndef SUDOKU_GENERATOR_HPP
+#define SUDOKU_GENERATOR_HPP
+
+#include "sudoku/sudoku.hpp"
+
+#include <random>
+#include <vector>
+
+namespace sudoku{
+
+    inline constexpr int max_generate_attempts = 1000; //Solved grids tried for one puzzle before giving up
+
+    //Makes 9x9 puzzles with exactly one solution
+    //A Generator only depends on its seed, so the same seed always gives the same puzzles
+    class Generator {
+        public:
+        explicit Generator(const uint64_t& seed);
+
+        //Random solved grid: the three diagonal boxes are filled at random, they never share a row or column,
+        //then the rest is solved, every value a given
+        Board fillGrid();
+        //Takes clues away from a solved grid in random order, putting back any that would leave more than one
+        //solution or make the puzzle harder than target. Returns false if no grid came out at exactly target
+        //in max_generate_attempts tries
+        bool generate(const Difficulty& target, Board& puzzle);
+
+        private:
+        std::mt19937_64 random;
+        Sudoku sudoku;
+
+        //True if puzzle has one solution and grades at or under target
+        bool keeps(const Board& puzzle, const Difficulty& target, Difficulty& grade);
+    };
+
+    //Makes count puzzles of difficulty target on threads, 0 for one per core
+    //Puzzle k comes from its own Generator seeded from seed and k, so the output is the same for any thread count
+    //A puzzle that could not be made is left as an empty Board, with no squares filled in
+    std::vector<Board> generatePuzzles(const std::size_t& count, const Difficulty& target, const uint64_t& seed,
+        const unsigned int& threads);
+
+} //End namespace sudoku
+
+#endif //SUDOKU_GENERATOR_HPP
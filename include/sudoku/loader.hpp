@@ -0,0 +1,52 @@
+#ifndef SUDOKU_LOADER_HPP
+#define SUDOKU_LOADER_HPP
+
+#include "sudoku/sudoku.hpp"
+
+#include <string>
+#include <string_view>
+
+namespace sudoku{
+
+    //Read only view of a whole file, memory mapped where the OS supports it
+    //Other platforms read the file into memory once, view() works the same either way
+    class MappedFile {
+        public:
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        //False if the file could not be opened, an empty file is open with an empty view
+        bool isOpen() const { return open; }
+        std::string_view view() const { return std::string_view(data, size); }
+
+        private:
+        const char* data = nullptr;
+        std::size_t size = 0;
+        bool open = false;
+        bool mapped = false;
+        std::string buffer;
+    };
+
+    //PuzzleScanner finds the puzzles in a block of text without copying it
+    //It understands the same layouts as PuzzleReader, titled grids and one puzzle per line
+    //Each record is a view into data holding exactly grid_size squares, ready for Sudoku::load
+    class PuzzleScanner {
+        public:
+        explicit PuzzleScanner(std::string_view data) : data(data) {}
+
+        //Sets record to the next puzzle. Returns false at end of data
+        bool next(std::string_view& record);
+        //Puzzles returned by next so far
+        std::size_t getCount() const { return count; }
+
+        private:
+        std::string_view data;
+        std::size_t pos = 0;
+        std::size_t count = 0;
+    };
+
+} //End namespace sudoku
+
+#endif //SUDOKU_LOADER_HPP
@@ -0,0 +1,20 @@
+#ifndef SUDOKU_PARALLEL_HPP
+#define SUDOKU_PARALLEL_HPP
+
+#include <cstddef>
+#include <functional>
+
+namespace sudoku{
+
+    //Runs task(worker, item) for every item in [0, count) on workers threads, the calling thread included
+    //Each worker starts with an even share of the items. A worker that runs out steals the back half of
+    //the largest share left, so a few slow items don't leave the other workers idle
+    void parallelFor(const std::size_t& count, const unsigned int& workers,
+        const std::function<void(unsigned int, std::size_t)>& task);
+
+    //Worker count to use when none is given, at least 1
+    unsigned int defaultWorkers();
+
+} //End namespace sudoku
+
+#endif //SUDOKU_PARALLEL_HPP
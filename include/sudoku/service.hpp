@@ -0,0 +1,114 @@
+#ifndef SUDOKU_SERVICE_HPP
+#define SUDOKU_SERVICE_HPP
+
+#include "sudoku/sudoku.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace sudoku{
+
+    inline constexpr unsigned int service_time_limit_ms = 1000; //Longest a request may solve for unless it asks otherwise
+    inline constexpr std::size_t service_max_pipelined = 256; //Requests a connection can have waiting before reading stops
+    inline constexpr std::size_t service_max_line = 4096; //Longest request line, a connection sending more is closed
+
+    //How requests are answered when they don't say
+    struct ServiceConfig {
+        unsigned int workers = 0; //Solver threads, 0 for one per core
+        SolveMethod method = HYBRID;
+        unsigned int timeLimitMs = service_time_limit_ms; //0 for no limit
+        std::size_t maxPipelined = service_max_pipelined;
+    };
+
+    //Answers one request line of the service protocol with sudoku, reused from request to request
+    //A request is a 9x9 puzzle on one line, grid_size squares with '.', '0', or '-' for blanks, optionally
+    //after options separated by spaces:
+    //  backtrack, rules, hybrid, or dlx  solve method
+    //  ms=<n>                            time limit in milliseconds, 0 for none
+    //  nodes=<n>                         search node limit, 0 for none
+    //The answer is one line of status, grid, and stats, "solved <grid> nodes=<n> us=<n>". The status is one of
+    //solved, unsolvable, stuck (rules could not finish), node_limit, timeout, cancelled, or invalid (breaks a rule)
+    //and the grid is the puzzle as given when it was not solved. A request that can't be read gets "error <reason>"
+    //cancel is passed on to the solve so a service shutting down can stop it
+    std::string answerRequest(std::string_view request, Sudoku& sudoku, const ServiceConfig& config,
+        const std::atomic<bool>* cancel = nullptr);
+
+    //Fixed set of threads, each with its own Sudoku kept for every task it runs, so nothing is set up per request
+    class SolverPool {
+        public:
+        using Task = std::function<void(Sudoku&)>;
+
+        explicit SolverPool(const unsigned int& workers);
+        //Runs every task already submitted before returning
+        ~SolverPool();
+        SolverPool(const SolverPool&) = delete;
+        SolverPool& operator=(const SolverPool&) = delete;
+
+        void submit(Task task);
+        std::size_t getWorkers() const { return threads.size(); }
+
+        private:
+        std::vector<std::thread> threads;
+        std::deque<Task> tasks;
+        std::mutex lock;
+        std::condition_variable ready;
+        bool stopping = false;
+
+        void work();
+    };
+
+    //Long running solver answering requests over a socket, each connection can send any number of request
+    //lines without waiting and gets the answers back in the same order. Requests from every connection share
+    //one SolverPool. Needs POSIX sockets, start() fails on other platforms
+    class SolverService {
+        public:
+        explicit SolverService(const ServiceConfig& config = ServiceConfig());
+        ~SolverService() { stop(); }
+        SolverService(const SolverService&) = delete;
+        SolverService& operator=(const SolverService&) = delete;
+
+        //Listens on address and returns once connections are being accepted, false if it could not listen
+        //"tcp:<port>" listens on localhost only, port 0 picks a free one. Anything else is a Unix domain socket path,
+        //any file already there is replaced
+        bool start(const std::string& address);
+        //Stops listening, cancels the solves running, and closes every connection. Safe to call more than once
+        void stop();
+
+        //TCP port being listened on, useful after asking for port 0
+        uint16_t getPort() const { return port; }
+        //Requests answered so far across all connections
+        std::size_t getAnswered() const { return answered; }
+
+        private:
+        struct Connection;
+
+        ServiceConfig config;
+        std::unique_ptr<SolverPool> pool;
+        std::atomic<bool> cancel{false};
+        std::atomic<std::size_t> answered{0};
+        int listener = -1;
+        int wake[2] = {-1, -1}; //Pipe written by stop() so the accept loop wakes up
+        std::string unixPath; //Removed again when the service stops
+        uint16_t port = 0;
+        std::thread acceptor;
+        std::mutex connectionsLock;
+        std::vector<std::shared_ptr<Connection>> connections;
+
+        void acceptLoop();
+        void serve(const std::shared_ptr<Connection>& connection);
+        void reply(const std::shared_ptr<Connection>& connection);
+        //Joins and forgets connections that have closed
+        void reap();
+    };
+
+} //End namespace sudoku
+
+#endif //SUDOKU_SERVICE_HPP
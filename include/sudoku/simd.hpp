@@ -0,0 +1,37 @@
+#ifndef SUDOKU_SIMD_HPP
+#define SUDOKU_SIMD_HPP
+
+#include "sudoku/sudoku.hpp"
+
+#include <array>
+
+namespace sudoku{
+
+    //Row, column, and box occupancy masks of a 9x9 grid, bit (val - 1) set if val is used
+    using UsedMasks = std::array<Candidates::mask_type, number_of_element_values>;
+
+    //Singles found in one pass over a 9x9 board
+    struct SinglesScan {
+        //Blank squares with exactly one possible, bit c of naked[r] for the square in row r, column c
+        std::array<uint16_t, number_of_element_values> naked{};
+        //Values that fit in exactly one blank square of each unit, in peer_tables.units order
+        std::array<Candidates::mask_type, unit_count> hidden{};
+        //A blank square has no possibles, or a unit has a missing value with nowhere to go
+        bool contradiction = false;
+    };
+
+    //Whole board kernels for 9x9 grids, with AVX2 versions picked at runtime when the CPU has it
+    //Sets the possibles of every blank square from the used masks and clears them on filled squares
+    void recomputePossibles(Board& board, const UsedMasks& rowUsed, const UsedMasks& colUsed, const UsedMasks& boxUsed);
+    SinglesScan scanSingles(const Board& board, const UsedMasks& rowUsed, const UsedMasks& colUsed, const UsedMasks& boxUsed);
+
+    //Plain versions, used when AVX2 is missing and to check the vector versions against
+    void recomputePossiblesScalar(Board& board, const UsedMasks& rowUsed, const UsedMasks& colUsed, const UsedMasks& boxUsed);
+    SinglesScan scanSinglesScalar(const Board& board, const UsedMasks& rowUsed, const UsedMasks& colUsed, const UsedMasks& boxUsed);
+
+    //True if the AVX2 kernels are the ones in use
+    bool simdEnabled();
+
+} //End namespace sudoku
+
+#endif //SUDOKU_SIMD_HPP
@@ -2,11 +2,23 @@
 #define SUDOKU_HPP
 
 #include <iostream>
-#include <unordered_set>
 #include <fstream>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
 #include <vector>
 #include <functional>
 #include <list>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <type_traits>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace sudoku{
 
@@ -14,30 +26,319 @@ namespace sudoku{
     typedef enum {
         NONE,
         RULES,
-        BACKTRACK
+        BACKTRACK,
+        HYBRID, //Backtracking on the square with fewest possibles, propagating singles after every guess
+        DLX //Exact cover with dancing links
     } SolveMethod;
 
+    //How hard a puzzle is, by the hardest rule it takes to solve
+    typedef enum {
+        EASY, //Naked and hidden singles
+        MEDIUM, //Pointing and box-line intersections as well
+        HARD, //Naked and hidden pairs and triples as well
+        EXPERT, //Rules alone get stuck, it takes guessing
+        DIFFICULTY_COUNT
+    } Difficulty;
+
+    //Where a search that can stop part way got to
+    typedef enum {
+        SOLVED,
+        NO_SOLUTION, //Every branch was tried, or the puzzle is not logical
+        PAUSED, //Ran out of nodes, resume() carries on from where it stopped
+        NODE_LIMIT, //Stopped by SolveLimits::maxNodes
+        TIMED_OUT, //Stopped by SolveLimits::deadline
+        CANCELLED //Stopped by SolveLimits::cancel
+    } SolveStatus;
+
+    inline constexpr unsigned int limit_check_interval = 256; //Nodes between looks at the clock and cancel flag
+
+    //Bounds on one solve, anything left as it is does not limit it
+    struct SolveLimits {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+        uint64_t maxNodes = 0; //Search nodes, 0 for no limit
+        const std::atomic<bool>* cancel = nullptr; //Set by another thread to stop the solve
+
+        //SOLVED while a search that has visited nodes so far can carry on, otherwise the limit it hit
+        //The node count is checked every node, the clock and flag cost more and are only read every
+        //limit_check_interval nodes, starting with the first
+        SolveStatus check(const uint64_t& nodes) const {
+            if (maxNodes != 0 && nodes > maxNodes){
+                return NODE_LIMIT;
+            }
+            if (nodes % limit_check_interval == 1){
+                if (cancel != nullptr && cancel->load(std::memory_order_relaxed)){
+                    return CANCELLED;
+                }
+                if (deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() >= deadline){
+                    return TIMED_OUT;
+                }
+            }
+            return SOLVED;
+        }
+    };
+
     // using namespace std;
 
-    inline constexpr auto blank_element_value = 10;
     inline constexpr auto blank_input_element_value = '-';
-    inline constexpr auto number_of_element_values = 9; //How many different values a square can have
-    inline constexpr auto grid_size = number_of_element_values*number_of_element_values; //size of grid
-    inline constexpr auto box_size = 3; //size of a box 
+    inline constexpr auto compact_blank_values = ".0"; //Extra blank symbols accepted in one line puzzles
+    inline constexpr auto max_box_size = 5; //Largest box supported, 25x25 grids
+    //Symbols for values 1 and up, digits first so 9x9 grids read the same as always
+    inline constexpr char value_symbols[] = "123456789ABCDEFGHIJKLMNOP";
+
+    //Bit helpers used by the candidate masks
+    inline int bitCount(const uint32_t& mask){
+#if defined(_MSC_VER)
+        return __popcnt(mask);
+#else
+        return __builtin_popcount(mask);
+#endif
+    }
+    //Index of the lowest set bit, mask must not be 0
+    inline int lowestBit(const uint32_t& mask){
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    //Entry c is the value char c stands for among the first Values symbols, 0 if none. Letters work in either case
+    template <int Values>
+    constexpr std::array<uint8_t, 256> makeSymbolTable(){
+        std::array<uint8_t, 256> table{};
+        for (int val = 1; val <= Values; ++val){
+            char c = value_symbols[val - 1];
+            table[uint8_t(c)] = val;
+            if (c >= 'A' && c <= 'Z'){
+                table[uint8_t(c - 'A' + 'a')] = val;
+            }
+        }
+        return table;
+    }
+
+    //Sizes and types for a grid made of BoxSize x BoxSize boxes
+    template <int BoxSize>
+    struct GridTraits {
+        static_assert(BoxSize >= 2 && BoxSize <= max_box_size, "Box size must be between 2 and 5");
+
+        static constexpr int box_size = BoxSize; //size of a box
+        static constexpr int number_of_element_values = BoxSize*BoxSize; //How many different values a square can have
+        static constexpr int grid_size = number_of_element_values*number_of_element_values; //size of grid
+        static constexpr int blank_element_value = number_of_element_values + 1;
+        static constexpr int unit_count = 3*number_of_element_values; //Rows, then columns, then boxes
+        static constexpr int unit_peer_count = number_of_element_values - 1; //Other squares in a row, column, or box
+        static constexpr int peer_count = 3*unit_peer_count - 2*(box_size - 1); //Distinct squares sharing a row, column, or box
+
+        //Narrowest types that fit, one bit per value and one index per square
+        using mask_type = std::conditional_t<(number_of_element_values <= 16), uint16_t, uint32_t>;
+        using index_type = std::conditional_t<(grid_size < 256), uint8_t, uint16_t>; //Loops run to grid_size, so it must fit too
+
+        //Location of a grid index
+        static constexpr index_type rowOf(const index_type& index){ return index / number_of_element_values; }
+        static constexpr index_type colOf(const index_type& index){ return index % number_of_element_values; }
+        static constexpr index_type boxOf(const index_type& index){
+            return (rowOf(index) / box_size)*box_size + (colOf(index) / box_size);
+        }
+
+        //Value c stands for in text, 0 if c is not a value symbol of this size. One table lookup per char
+        static constexpr std::array<uint8_t, 256> symbol_table = makeSymbolTable<number_of_element_values>();
+        static constexpr uint8_t valueOf(const char& c){ return symbol_table[uint8_t(c)]; }
+        static constexpr char symbolOf(const uint8_t& val){ return value_symbols[val - 1]; }
+    };
+
+    //Candidates is the set of possible values of a square stored as a bitmask
+    //Bit (val - 1) is set when val is possible, iteration is in ascending order
+    template <int BoxSize>
+    class BasicCandidates {
+        public:
+        using mask_type = typename GridTraits<BoxSize>::mask_type;
+        static constexpr int number_of_element_values = GridTraits<BoxSize>::number_of_element_values;
+        static constexpr mask_type all_mask = mask_type((uint64_t(1) << number_of_element_values) - 1);
+
+        class iterator {
+            public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = uint8_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const uint8_t*;
+            using reference = uint8_t;
+
+            iterator() = default;
+            explicit iterator(const mask_type& mask) : mask(mask) {}
+            uint8_t operator*() const { return lowestBit(mask) + 1; }
+            iterator& operator++(){ mask &= mask - 1; return *this; }
+            bool operator==(const iterator& other) const { return mask == other.mask; }
+            bool operator!=(const iterator& other) const { return mask != other.mask; }
+
+            private:
+            mask_type mask = 0;
+        };
+
+        BasicCandidates() = default;
+        BasicCandidates(std::initializer_list<uint8_t> vals){
+            for (uint8_t val : vals){
+                insert(val);
+            }
+        }
+        static BasicCandidates fromMask(const mask_type& mask){
+            BasicCandidates c;
+            c.bits = mask & all_mask;
+            return c;
+        }
+
+        mask_type mask() const { return bits; }
+        std::size_t size() const { return bitCount(bits); }
+        bool empty() const { return bits == 0; }
+        bool contains(const uint8_t& val) const {
+            return val > 0 && val <= number_of_element_values && (bits & bit(val));
+        }
+        //Returns false if val is out of range or already present
+        bool insert(const uint8_t& val){
+            if (val == 0 || val > number_of_element_values || (bits & bit(val))){
+                return false;
+            }
+            bits |= bit(val);
+            return true;
+        }
+        void erase(const uint8_t& val){
+            if (val > 0 && val <= number_of_element_values){
+                bits &= ~bit(val);
+            }
+        }
+        void clear() { bits = 0; }
+
+        iterator begin() const { return iterator(bits); }
+        iterator end() const { return iterator(); }
+
+        bool operator==(const BasicCandidates& other) const { return bits == other.bits; }
+        bool operator!=(const BasicCandidates& other) const { return bits != other.bits; }
+
+        static mask_type bit(const uint8_t& val) { return mask_type(uint32_t(1) << (val - 1)); }
+
+        private:
+        mask_type bits = 0;
+    };
+
+    inline constexpr auto max_split_depth = 3; //Branch squares expanded before handing subtrees to threads
+    inline constexpr auto split_subtrees_per_thread = 4; //Splitting stops early once there are this many per thread
+
+#ifndef SUDOKU_SOLVE_STATS
+#define SUDOKU_SOLVE_STATS 1
+#endif
+    //Built with SUDOKU_SOLVE_STATS=0 nothing is recorded and every stat stays 0
+    inline constexpr bool solve_stats_enabled = SUDOKU_SOLVE_STATS;
+
+    //Deductions counted by SolveStats
+    typedef enum {
+        NAKED_SINGLE,
+        HIDDEN_SINGLE,
+        NAKED_PAIR,
+        NAKED_TRIPLE,
+        HIDDEN_PAIR,
+        HIDDEN_TRIPLE,
+        INTERSECTION, //Pointing and box-line reduction
+        RULE_COUNT
+    } SolveRule;
+
+    //What a Sudoku did since its puzzle was read in, to see why a puzzle was slow
+    struct SolveStats {
+        uint64_t nodes = 0; //Search nodes, the same as steps for backtracking, hybrid, and DLX
+        uint64_t backtracks = 0; //Search nodes that were undone, every node off the solved path
+        uint16_t maxDepth = 0; //Most guesses stacked at once
+        std::array<uint64_t, RULE_COUNT> deductions{}; //Singles placed and eliminating rules applied, by SolveRule
+        uint64_t eliminations = 0; //Values removed from the possibles of blank squares
+        //Wall time, search does not include the propagation done under it
+        double parseSeconds = 0;
+        double propagateSeconds = 0;
+        double searchSeconds = 0;
+
+        //Adds the counts from a copy that searched part of the tree, times overlap so they are left out
+        void addCounts(const SolveStats& other);
+        void print() const;
+    };
+
+    //Compile time tables of the squares related to each index
+    //row, col, and box keep the order eachInRow, eachInCol, and eachInBox have always visited in
+    template <int BoxSize>
+    struct PeerTables {
+        using traits = GridTraits<BoxSize>;
+        using index_type = typename traits::index_type;
+
+        std::array<std::array<index_type, traits::unit_peer_count>, traits::grid_size> row{};
+        std::array<std::array<index_type, traits::unit_peer_count>, traits::grid_size> col{};
+        std::array<std::array<index_type, traits::unit_peer_count>, traits::grid_size> box{};
+        std::array<std::array<index_type, traits::peer_count>, traits::grid_size> all{};
+        //Every square of each unit, in the same order as the unit's positions masks
+        std::array<std::array<index_type, traits::number_of_element_values>, traits::unit_count> units{};
+    };
+
+    template <int BoxSize>
+    constexpr PeerTables<BoxSize> makePeerTables(){
+        using traits = GridTraits<BoxSize>;
+        constexpr int n = traits::number_of_element_values;
+        constexpr int b = traits::box_size;
+        PeerTables<BoxSize> tables{};
+        for (int index = 0; index < traits::grid_size; ++index){
+            int row = traits::rowOf(index);
+            int col = traits::colOf(index);
+            int boxRow = (row / b)*b;
+            int boxCol = (col / b)*b;
+            int r = 0, c = 0, x = 0, a = 0;
+            for (int i = 0; i < n; ++i){
+                if (i != col){
+                    tables.row[index][r++] = row*n + i;
+                    tables.all[index][a++] = row*n + i;
+                }
+                if (i != row){
+                    tables.col[index][c++] = i*n + col;
+                    tables.all[index][a++] = i*n + col;
+                }
+                int target = (boxRow + i / b)*n + boxCol + i % b;
+                if (index == row*n){
+                    tables.units[row][i] = index + i;
+                }
+                if (index == col){
+                    tables.units[n + col][i] = i*n + col;
+                }
+                if (index == boxRow*n + boxCol){
+                    tables.units[2*n + traits::boxOf(index)][i] = target;
+                }
+                if (target != index){
+                    tables.box[index][x++] = target;
+                    //Squares sharing the row or column were already added
+                    if (traits::rowOf(target) != row && traits::colOf(target) != col){
+                        tables.all[index][a++] = target;
+                    }
+                }
+            }
+        }
+        return tables;
+    }
+
+    //Built once per box size, only for the sizes that are used
+    template <int BoxSize>
+    inline constexpr PeerTables<BoxSize> peer_tables_for = makePeerTables<BoxSize>();
 
     //Square class represents a square on the grid
-    class Square {
+    template <int BoxSize>
+    class BasicSquare {
         public:
+        using Candidates = BasicCandidates<BoxSize>;
+        static constexpr int number_of_element_values = GridTraits<BoxSize>::number_of_element_values;
+        static constexpr int blank_element_value = GridTraits<BoxSize>::blank_element_value;
+
         bool isGiven() const { return given; }
-        Square() = default;
-        Square(const uint8_t& val){
+        BasicSquare() = default;
+        BasicSquare(const uint8_t& val){
             this->element = val;
             this->originalValue = val;
         }
-        Square(const uint8_t& val, const bool& given) : Square(val){
+        BasicSquare(const uint8_t& val, const bool& given) : BasicSquare(val){
             this->given = given;
         }
-        Square(const uint8_t& val, const std::unordered_set<uint8_t>& possible) : Square(val){
+        BasicSquare(const uint8_t& val, const Candidates& possible) : BasicSquare(val){
             this->possibles = possible;
         }
         void setToOriginalValue(){
@@ -57,11 +358,11 @@ namespace sudoku{
         bool isBlank() const {
             return this->element == blank_element_value;
         }
-        std::unordered_set<uint8_t> getPossibles() const {
+        Candidates getPossibles() const {
             return this->possibles;
         }
         bool addPossible(const uint8_t& val){
-            return possibles.insert(val).second;
+            return possibles.insert(val);
         }
         void removePossible(const uint8_t& val) {
             possibles.erase(val);
@@ -69,7 +370,7 @@ namespace sudoku{
 
         //What if checked between possible filling?
         bool checkPossibles() const {
-            if (element == blank_element_value && possibles.size() == 0){
+            if (element == blank_element_value && possibles.empty()){
                 return false;
             }
             return true;
@@ -77,59 +378,390 @@ namespace sudoku{
         void removeAllPossibles() {
             possibles.clear();
         }
+        void setPossibles(const Candidates& possible) {
+            possibles = possible;
+        }
 
         private:
         uint8_t element = blank_element_value;
         uint8_t originalValue = blank_element_value;
-        std::unordered_set<uint8_t> possibles;
+        Candidates possibles;
         bool given = false;
 
     };
 
+    //Board holds every square of a grid in two fixed size arrays, one byte per value and one mask per square
+    //It never allocates and is trivially copyable, so a copy is a single memcpy (244 bytes for 9x9)
+    template <int BoxSize>
+    struct BasicBoard {
+        using traits = GridTraits<BoxSize>;
+        using index_type = typename traits::index_type;
+        using mask_type = typename traits::mask_type;
+        using Candidates = BasicCandidates<BoxSize>;
+        using Square = BasicSquare<BoxSize>;
+
+        static constexpr int grid_size = traits::grid_size;
+        static constexpr uint8_t given_bit = 0x80;
+        static constexpr uint8_t value_bits = 0x7f;
+
+        //Value of each square or blank_element_value, given_bit set for givens
+        std::array<uint8_t, grid_size> cells;
+        //Possible values of each square, bit (val - 1) set if val is possible
+        std::array<mask_type, grid_size> possibles{};
+
+        BasicBoard(){ cells.fill(traits::blank_element_value); }
+
+        //Square like view of one square of the board, changes go straight to the board
+        template <typename BoardType>
+        class SquareRef {
+            public:
+            SquareRef(BoardType& board, const index_type& index) : board(board), index(index) {}
+
+            bool isGiven() const { return board.cells[index] & given_bit; }
+            uint8_t getElement() const { return board.cells[index] & value_bits; }
+            //Givens are never blank, so the given bit doesn't need masking off
+            bool isBlank() const { return board.cells[index] == traits::blank_element_value; }
+            Candidates getPossibles() const { return Candidates::fromMask(board.possibles[index]); }
+            bool checkPossibles() const { return !isBlank() || board.possibles[index] != 0; }
+
+            bool setElement(const uint8_t& val){
+                if (val > 0 && val <= traits::number_of_element_values){
+                    board.cells[index] = (board.cells[index] & given_bit) | val;
+                    return true;
+                }
+                return false;
+            }
+            //Only givens keep their value
+            void setToOriginalValue(){
+                if (!isGiven()){
+                    board.cells[index] = traits::blank_element_value;
+                }
+            }
+            bool addPossible(const uint8_t& val){
+                Candidates possible = getPossibles();
+                bool added = possible.insert(val);
+                board.possibles[index] = possible.mask();
+                return added;
+            }
+            void removePossible(const uint8_t& val){ board.possibles[index] &= ~Candidates::bit(val); }
+            void setPossibles(const Candidates& possible){ board.possibles[index] = possible.mask(); }
+            void removeAllPossibles(){ board.possibles[index] = 0; }
+
+            operator Square() const {
+                Square square = isGiven() ? Square(getElement(), true) : Square();
+                if (!isGiven() && !isBlank()){
+                    square.setElement(getElement());
+                }
+                square.setPossibles(getPossibles());
+                return square;
+            }
+
+            private:
+            BoardType& board;
+            index_type index;
+        };
+
+        SquareRef<BasicBoard> operator[](const index_type& index){ return SquareRef<BasicBoard>(*this, index); }
+        SquareRef<const BasicBoard> operator[](const index_type& index) const { return SquareRef<const BasicBoard>(*this, index); }
+
+        //Copies square into the board at index
+        void set(const index_type& index, const Square& square){
+            cells[index] = square.getElement() | (square.isGiven() ? given_bit : 0);
+            possibles[index] = square.getPossibles().mask();
+        }
+    };
+
     //Sudoku class represents a Sudoku grid filled with grid_size squares
-    class Sudoku {
+    //BoxSize picks the grid, 3 for the usual 9x9, up to 5 for 25x25
+    template <int BoxSize>
+    class BasicSudoku {
         public:
-        Sudoku() = default;
-        Sudoku(std::ifstream &in);
-        Sudoku(std::ifstream &in, const SolveMethod& solver);
+        using traits = GridTraits<BoxSize>;
+        using index_type = typename traits::index_type;
+        using mask_type = typename traits::mask_type;
+        using Candidates = BasicCandidates<BoxSize>;
+        using Square = BasicSquare<BoxSize>;
+        using Board = BasicBoard<BoxSize>;
+
+        static constexpr int box_size = traits::box_size;
+        static constexpr int number_of_element_values = traits::number_of_element_values;
+        static constexpr int grid_size = traits::grid_size;
+        static constexpr int blank_element_value = traits::blank_element_value;
+        static constexpr int unit_count = traits::unit_count;
+        static constexpr int peer_count = traits::peer_count;
+        static constexpr const PeerTables<BoxSize>& peer_tables = peer_tables_for<BoxSize>;
+
+        BasicSudoku() = default;
+        //Reads squares from in until the grid is full, skipping anything that is not a grid symbol
+        BasicSudoku(std::istream &in);
+        BasicSudoku(std::istream &in, const SolveMethod& solver);
+
+        //Replaces the grid with the first grid_size squares of puzzle, using the same symbols as file input
+        //plus '.' and '0' for blanks. The board is built straight from the bytes, so puzzle can point into
+        //a mapped file. Reuses the grid's memory, so one Sudoku can work through many puzzles. Returns isLogical()
+        bool load(std::string_view puzzle);
+        //Same with the squares taken from board, values and given squares are kept and possibles worked out again
+        bool load(const Board& board);
 
         bool isLogical() const { return logical; }
         SolveMethod getSolverType() const { return solver; }
         bool setSolverType(const SolveMethod& solver) { this->solver = solver; return true; }
+        unsigned int getSteps() const { return steps; }
+        const SolveStats& getStats() const { return stats; }
 
         //Check if square current value is valid
-        bool checkSquare(const uint8_t& index);
+        bool checkSquare(const index_type& index);
         //Check if blank square is valid with a potential value
-        bool checkSquare(const uint8_t& index, const uint8_t& potential);
+        bool checkSquare(const index_type& index, const uint8_t& potential);
 
         //Assigns a value to a blank square and removes it from possible values of related squares
-        bool assignSquare(const uint8_t& index, const uint8_t& val);
+        bool assignSquare(const index_type& index, const uint8_t& val);
 
-        std::vector<Square> getGrid() const { return grid; }
+        //Interactive moves, recorded on the trail so they can be taken back without reading the puzzle in again
+        //load() and solve() start the move history over
+        //Places val in a blank square if it is still one of the square's possibles, returns false otherwise
+        //The move is kept even if it leaves a related square with no possibles, isSolvable() reports that
+        bool place(const index_type& index, const uint8_t& val);
+        //Takes back the last place(), returns false if there is nothing to undo
+        bool undo();
+        std::size_t getMoveCount() const { return moves.size(); }
+        //Values still possible for a square, empty once it is filled
+        Candidates candidates(const index_type& index) const;
+        //True if the grid can still be completed. The last solution found is reused while every filled square
+        //agrees with it, otherwise a hybrid search runs from the current grid and is undone afterwards
+        bool isSolvable();
+
+        //Copy of the squares read in, fewer than grid_size if the input was too short
+        std::vector<Square> getGrid() const;
+        //The whole grid as one fixed size value, cheap to copy and keep as a snapshot
+        Board getBoard() const { return grid; }
         void printGrid() const;
+        //Appends the grid to out as one line of grid_size symbols, '-' for blanks
+        void appendLine(std::string& out) const;
         bool solve();
+        //solve() that gives up once a limit is hit, returning NODE_LIMIT, TIMED_OUT, or CANCELLED with the grid
+        //left as it was. RULES never searches and always runs to the end
+        SolveStatus solve(const SolveLimits& limits);
+        SolveStatus solve(const std::chrono::steady_clock::time_point& deadline);
+        //Counts solutions with the hybrid search, stopping as soon as limit have been found
+        //The grid is left as it was, steps counts the nodes visited
+        unsigned int countSolutions(const unsigned int& limit);
+        bool hasUniqueSolution() { return countSolutions(2) == 1; }
+        //Hardest rule solving the puzzle with rules needs, worked out on a copy so the grid is left as it is
+        //Puzzles with no solution grade as EXPERT
+        Difficulty grade() const;
+        //Hybrid search with the top of the search tree split across threads
+        //Each subtree is searched on its own copy of the grid and the first solution found stops the rest
+        bool solveParallel(const unsigned int& threads);
+        //Backtracking solve that can be time sliced, visiting at most nodeBudget nodes, 0 for no limit
+        //On PAUSED the search is kept as it is and the grid holds its guesses so far
+        SolveStatus solveFor(const uint64_t& nodeBudget);
+        //Carries on a paused search with a new budget, nodes and steps keep adding up as if it never stopped
+        //Anything else that searches or changes the grid drops a paused search, putting the grid back as it was
+        //before solveFor(): load(), solve(), place(), isSolvable(), countSolutions(), and solveParallel()
+        //grade() works from the grid without the guesses too
+        SolveStatus resume(const uint64_t& nodeBudget);
+        bool isPaused() const { return paused; }
 
         //Algorithms that iterate rows, columns, and boxes and perfrom func on each element
         //Return false if any result of func returns false
-        bool eachInRow(const uint8_t& index, const std::function<bool(uint8_t, std::vector<Square>&)>& func);
-        bool eachInCol(const uint8_t& index, const std::function<bool(uint8_t, std::vector<Square>&)>& func);
-        bool eachInBox(const uint8_t& index, const std::function<bool(uint8_t, std::vector<Square>&)>& func);
+        bool eachInRow(const index_type& index, const std::function<bool(index_type, Board&)>& func);
+        bool eachInCol(const index_type& index, const std::function<bool(index_type, Board&)>& func);
+        bool eachInBox(const index_type& index, const std::function<bool(index_type, Board&)>& func);
+
+        //Same as the eachIn functions but take any callable so the calls can be inlined
+        //visitPeers covers every related square once
+        template <typename Func>
+        bool visitRow(const index_type& index, Func&& func){ return visit(peer_tables.row[index], func); }
+        template <typename Func>
+        bool visitCol(const index_type& index, Func&& func){ return visit(peer_tables.col[index], func); }
+        template <typename Func>
+        bool visitBox(const index_type& index, Func&& func){ return visit(peer_tables.box[index], func); }
+        template <typename Func>
+        bool visitPeers(const index_type& index, Func&& func){ return visit(peer_tables.all[index], func); }
 
         private:
-        std::vector<Square> grid;
+        Board grid;
+        //Squares read in, grid_size for a full grid
+        uint16_t squares = 0;
         bool logical = false;
 
         unsigned int steps = 0;
+        SolveStats stats;
         SolveMethod solver = NONE;
-        
 
-        //Solve function(s)
+        //Values already placed in each row, column, and box, bit (val - 1) set if val is used
+        std::array<mask_type, number_of_element_values> rowUsed{};
+        std::array<mask_type, number_of_element_values> colUsed{};
+        std::array<mask_type, number_of_element_values> boxUsed{};
+
+        //Undo log for the hybrid search, each entry holds a square as it was before a change
+        struct TrailEntry {
+            index_type index;
+            uint8_t cell;
+            mask_type possibles;
+        };
+        std::vector<TrailEntry> trail;
+        //Trail length and dead squares before each place(), popped by undo()
+        struct Move {
+            std::size_t mark;
+            uint16_t dead;
+        };
+        std::vector<Move> moves;
+        //Blank squares the moves have left with no possibles
+        uint16_t deadSquares = 0;
+        //Last solution isSolvable() found, reused until a move disagrees with it
+        Board witness;
+        bool hasWitness = false;
+        //Backtracking search, kept between calls so a paused search can carry on
+        //Blanks are filled in index order, so the square at depth d is always blanks[d], no scan to find it
+        struct SearchFrame {
+            index_type index;
+            mask_type remaining; //Values not tried yet
+        };
+        std::array<SearchFrame, grid_size> frames;
+        std::array<index_type, grid_size> blanks;
+        uint16_t blankCount = 0;
+        uint16_t searchDepth = 0;
+        bool entering = false; //The node at depth has been reached but not visited yet
+        bool paused = false;
+        //Set by another thread to stop searchHybrid early
+        const std::atomic<bool>* cancelled = nullptr;
+        //Limits of the solve running, nullptr when there are none
+        const SolveLimits* limits = nullptr;
+        unsigned int limitStart = 0; //steps when the solve started
+        SolveStatus stopped = SOLVED; //Limit that stopped the solve, SOLVED until one does
+
+        //Sets up masks and possibles for a freshly read grid
+        void initialize();
+        bool fillPossibles();
+
+        //Solve function(s), depth is the number of guesses already made
         bool solveBacktrack();
+        //Sets up the backtracking search at the root, then runBacktrack() visits up to budget nodes
+        void startBacktrack();
+        SolveStatus runBacktrack(const uint64_t& budget);
+        //Takes the guesses of a paused search back off the board, nothing to do if there isn't one
+        void dropPaused();
+        bool solveRules();
+        //The solveRules loop, raising hardest to the hardest rule that changed the grid
+        bool applyRules(Difficulty& hardest);
+        bool solveHybrid();
+        bool searchHybrid(const uint16_t& depth = 0);
+        //Adds the solutions below the current node to count, returns true once count reaches limit
+        bool countHybrid(const unsigned int& limit, unsigned int& count, const uint16_t& depth = 0);
+        //True once another thread found a solution or a limit was hit, the search then unwinds
+        bool stopSearch();
+        //Blank square with the fewest possibles, -1 if the grid is full
+        int pickBranchSquare() const;
+        bool solveDlx();
+
+        //Places val and removes it from the related squares, recording every change on the trail
+        //Returns false if a related square is left with no possibles
+        bool placeTrailed(const index_type& index, const uint8_t& val);
+        //Places naked and hidden singles until there are none left, returns false on a contradiction
+        bool propagateSingles();
+        //propagateSingles for any size, working unit by unit
+        bool propagateUnits();
+        //propagateSingles for 9x9, working from whole board scans
+        bool propagateScanned();
+        //Restores every square changed since the trail was mark entries long
+        void undoTrail(const std::size_t& mark);
+
+        //Rules used by solveRules, each returns true if it changed the grid
+        bool applyNakedSingles();
+        bool applyHiddenSingles();
+        bool applyNakedSubsets(const uint8_t& size);
+        bool applyHiddenSubsets(const uint8_t& size);
+        bool applyIntersections();
+        //Removes the values in mask from a blank square's possibles, returns true if any were removed
+        bool eliminate(const index_type& index, const mask_type& mask);
+        //Positions in unit where val is still possible, bit p set for the unit's p-th square
+        mask_type unitPositions(const uint8_t& unit, const uint8_t& val) const;
+        mask_type unitUsed(const uint8_t& unit) const;
+        bool hasContradiction() const;
+        bool isSolved() const;
+
+        //Occupancy helpers, kept in sync with every value placed or removed from the grid
+        mask_type usedMask(const index_type& index) const {
+            return rowUsed[traits::rowOf(index)] | colUsed[traits::colOf(index)] | boxUsed[traits::boxOf(index)];
+        }
+        void markUsed(const index_type& index, const uint8_t& val);
+        void clearUsed(const index_type& index, const uint8_t& val);
+        //Reverts an assigned square back to blank
+        void unassignSquare(const index_type& index);
+
+        //Stat helpers, empty when solve_stats_enabled is false
+        void countNode(const uint16_t& depth){
+            if constexpr (solve_stats_enabled){
+                ++stats.nodes;
+                stats.maxDepth = std::max(stats.maxDepth, depth);
+            }
+        }
+        void countBacktrack(){
+            if constexpr (solve_stats_enabled){
+                ++stats.backtracks;
+            }
+        }
+        void countDeduction(const SolveRule& rule){
+            if constexpr (solve_stats_enabled){
+                ++stats.deductions[rule];
+            }
+        }
+        void countEliminations(const mask_type& removed){
+            if constexpr (solve_stats_enabled){
+                stats.eliminations += bitCount(removed);
+            }
+        }
+        //Runs search and adds its time, less the propagation done inside it, to the search time
+        template <typename Func>
+        bool timeSearch(Func&& search);
 
         //Helper functions
-        void printGridStdout(const std::vector<Square>& grid, const bool& printGivens = false) const;
+        template <typename Peers, typename Func>
+        bool visit(const Peers& peers, Func& func){
+            for (index_type target : peers){
+                if (!func(target, grid)){
+                    return false;
+                }
+            }
+            return true;
+        }
+        void printGridStdout(const bool& printGivens = false) const;
     };
 
+    //The usual 9x9 grid, names and values the rest of the project was written against
+    using Candidates = BasicCandidates<3>;
+    using Square = BasicSquare<3>;
+    using Board = BasicBoard<3>;
+    using Sudoku = BasicSudoku<3>;
+
+    inline constexpr auto blank_element_value = GridTraits<3>::blank_element_value;
+    inline constexpr auto number_of_element_values = GridTraits<3>::number_of_element_values; //How many different values a square can have
+    inline constexpr auto grid_size = GridTraits<3>::grid_size; //size of grid
+    inline constexpr auto box_size = GridTraits<3>::box_size; //size of a box 
+    inline constexpr auto unit_count = GridTraits<3>::unit_count; //Rows, then columns, then boxes
+    inline constexpr auto unit_peer_count = GridTraits<3>::unit_peer_count; //Other squares in a row, column, or box
+    inline constexpr auto peer_count = GridTraits<3>::peer_count; //Distinct squares sharing a row, column, or box
+    inline constexpr const PeerTables<3>& peer_tables = peer_tables_for<3>;
+
+    inline constexpr uint8_t rowOf(const uint8_t& index){ return GridTraits<3>::rowOf(index); }
+    inline constexpr uint8_t colOf(const uint8_t& index){ return GridTraits<3>::colOf(index); }
+    inline constexpr uint8_t boxOf(const uint8_t& index){ return GridTraits<3>::boxOf(index); }
+
+    //Other sizes the library is built for
+    using Sudoku4 = BasicSudoku<2>;
+    using Sudoku16 = BasicSudoku<4>;
+    using Sudoku25 = BasicSudoku<5>;
+
+    static_assert(std::is_trivially_copyable_v<Board>, "Board must copy with memcpy");
+    static_assert(sizeof(Board) <= 256, "9x9 Board should stay under 256 bytes");
+
+    extern template class BasicSudoku<2>;
+    extern template class BasicSudoku<3>;
+    extern template class BasicSudoku<4>;
+    extern template class BasicSudoku<5>;
+
 } //End namespace sudoku
 
 #endif //SUDOKU_HPP
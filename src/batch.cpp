@@ -0,0 +1,247 @@
+#include "sudoku/batch.hpp"
+#include "sudoku/loader.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sudoku {
+
+    bool PuzzleReader::next(std::string& puzzle){
+        puzzle.clear();
+        while (std::getline(in, line)){
+            //Squares on this line, grid rows are added to the puzzle until it is full
+            std::size_t start = puzzle.size();
+            for (char c : line){
+                if ((c > '0' && c <= '9') || c == blank_input_element_value){
+                    puzzle.push_back(c);
+                }
+                else if (c != '\0' && std::strchr(compact_blank_values, c)){
+                    puzzle.push_back(blank_input_element_value);
+                }
+            }
+            std::size_t squares = puzzle.size() - start;
+
+            if (squares == grid_size){
+                //A whole puzzle on one line replaces any unfinished grid
+                puzzle.erase(0, start);
+                ++count;
+                return true;
+            }
+            if (squares == number_of_element_values && start + squares <= grid_size){
+                if (puzzle.size() == grid_size){
+                    ++count;
+                    return true;
+                }
+                continue;
+            }
+            //Titles and decorations have no squares, anything else breaks up the current grid
+            puzzle.resize(squares == 0 ? start : 0);
+        }
+        return false;
+    }
+
+    namespace {
+        //Batch loops shared by streams and in memory text
+        //Reader is a PuzzleReader handing out strings or a PuzzleScanner handing out views, Puzzle is what it hands out
+        template <typename Reader, typename Puzzle>
+        BatchResult solveAll(Reader& reader, const SolveMethod& solver, const BatchCallback& onResult){
+            BatchResult result;
+            auto start = std::chrono::steady_clock::now();
+
+            Sudoku sudoku;
+            sudoku.setSolverType(solver);
+            Puzzle puzzle;
+
+            while (reader.next(puzzle)){
+                bool solved = sudoku.load(puzzle) && sudoku.solve();
+                //solve() turns NONE into BACKTRACK, keep every puzzle on the requested method
+                sudoku.setSolverType(solver);
+                if (solved){
+                    ++result.solved;
+                }
+                else{
+                    ++result.failed;
+                }
+                if (onResult){
+                    onResult(reader.getCount() - 1, sudoku, solved);
+                }
+            }
+
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return result;
+        }
+
+        template <typename Reader, typename Puzzle>
+        BatchResult solveAllParallel(Reader& reader, const SolveMethod& solver, const unsigned int& threads,
+            const LineCallback& onResult){
+            BatchResult result;
+            auto start = std::chrono::steady_clock::now();
+
+            unsigned int workers = std::max(1u, threads);
+            std::size_t window = std::size_t(batch_window_per_worker)*workers;
+
+            //Ring of window slots, puzzle k lives in slot k % window from when it is read until its line is handed out
+            //Buffers are sized once and reused for every puzzle
+            std::vector<Puzzle> puzzles(window);
+            std::string lines(window*grid_size, blank_input_element_value);
+            std::vector<char> solved(window);
+            std::vector<char> done(window);
+            std::vector<std::size_t> positions(window); //Where each puzzle was in the input, see BatchCallback
+
+            std::mutex lock;
+            std::condition_variable ready; //Next line to hand out is done, or the input ran out
+            std::condition_variable space; //A slot was handed out
+            std::size_t read = 0; //Puzzles read so far
+            std::size_t claimed = 0; //Puzzles a worker has started on
+            std::size_t written = 0; //Lines handed to onResult
+            bool finished = false; //Reader is out of puzzles
+
+            //Workers read under the lock, whoever runs out of puzzles reads the next few and takes them, so a slow
+            //puzzle only holds up the others once the whole ring behind it is full
+            auto work = [&] (){
+                Sudoku sudoku;
+                std::string out;
+                while (true){
+                    std::size_t first, end;
+                    {
+                        std::unique_lock<std::mutex> guard(lock);
+                        space.wait(guard, [&] { return claimed < read || finished || read - written < window; });
+                        if (claimed == read){
+                            while (!finished && read - claimed < batch_claim && read - written < window){
+                                if (reader.next(puzzles[read % window])){
+                                    positions[read % window] = reader.getCount() - 1;
+                                    ++read;
+                                }
+                                else{
+                                    finished = true;
+                                    ready.notify_one();
+                                    space.notify_all();
+                                }
+                            }
+                        }
+                        if (claimed == read){
+                            return;
+                        }
+                        first = claimed;
+                        end = claimed = std::min<std::size_t>(read, claimed + batch_claim);
+                    }
+
+                    for (std::size_t k = first; k < end; ++k){
+                        std::size_t slot = k % window;
+                        sudoku.setSolverType(solver);
+                        solved[slot] = sudoku.load(puzzles[slot]) && sudoku.solve();
+                        //The reader only hands out whole puzzles, so every line is grid_size long
+                        out.clear();
+                        sudoku.appendLine(out);
+                        std::copy(out.begin(), out.end(), lines.begin() + slot*grid_size);
+                    }
+
+                    std::lock_guard<std::mutex> guard(lock);
+                    for (std::size_t k = first; k < end; ++k){
+                        done[k % window] = true;
+                    }
+                    if (first == written){
+                        ready.notify_one();
+                    }
+                }
+            };
+            std::vector<std::thread> pool;
+            for (unsigned int w = 0; w < workers; ++w){
+                pool.emplace_back(work);
+            }
+
+            //This thread hands lines out in input order, as many as are done at a time
+            std::unique_lock<std::mutex> guard(lock);
+            while (true){
+                ready.wait(guard, [&] { return done[written % window] || (finished && written == read); });
+                if (!done[written % window]){
+                    break;
+                }
+                std::size_t end = written;
+                while (end < read && done[end % window]){
+                    ++end;
+                }
+                guard.unlock();
+                for (std::size_t k = written; k < end; ++k){
+                    std::size_t slot = k % window;
+                    if (solved[slot]){
+                        ++result.solved;
+                    }
+                    else{
+                        ++result.failed;
+                    }
+                    if (onResult){
+                        onResult(positions[slot], std::string_view(lines).substr(slot*grid_size, grid_size), solved[slot]);
+                    }
+                }
+                guard.lock();
+                for (std::size_t k = written; k < end; ++k){
+                    done[k % window] = false;
+                }
+                written = end;
+                space.notify_all();
+            }
+            guard.unlock();
+            for (std::thread& t : pool){
+                t.join();
+            }
+
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return result;
+        }
+    }
+
+    LineWriter::LineWriter(std::FILE* out, const std::size_t& flushBytes) : out(out), flushBytes(flushBytes) {
+        buffer.reserve(flushBytes + grid_size + 1);
+    }
+
+    void LineWriter::write(std::string_view line){
+        buffer.append(line);
+        buffer.push_back('\n');
+        if (buffer.size() >= flushBytes){
+            flush();
+        }
+    }
+
+    bool LineWriter::flush(){
+        bool written = std::fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size();
+        buffer.clear();
+        return std::fflush(out) == 0 && written;
+    }
+
+    BatchResult solveBatch(std::istream& in, const SolveMethod& solver, const BatchCallback& onResult){
+        PuzzleReader reader(in);
+        return solveAll<PuzzleReader, std::string>(reader, solver, onResult);
+    }
+
+    BatchResult solveBatch(std::string_view data, const SolveMethod& solver, const BatchCallback& onResult){
+        PuzzleScanner scanner(data);
+        return solveAll<PuzzleScanner, std::string_view>(scanner, solver, onResult);
+    }
+
+    BatchResult solveBatch(BinaryReader& reader, const SolveMethod& solver, const BatchCallback& onResult){
+        return solveAll<BinaryReader, Board>(reader, solver, onResult);
+    }
+
+    BatchResult solveBatchParallel(std::istream& in, const SolveMethod& solver, const unsigned int& threads,
+        const LineCallback& onResult){
+        PuzzleReader reader(in);
+        return solveAllParallel<PuzzleReader, std::string>(reader, solver, threads, onResult);
+    }
+
+    BatchResult solveBatchParallel(std::string_view data, const SolveMethod& solver, const unsigned int& threads,
+        const LineCallback& onResult){
+        PuzzleScanner scanner(data);
+        return solveAllParallel<PuzzleScanner, std::string_view>(scanner, solver, threads, onResult);
+    }
+
+    BatchResult solveBatchParallel(BinaryReader& reader, const SolveMethod& solver, const unsigned int& threads,
+        const LineCallback& onResult){
+        return solveAllParallel<BinaryReader, Board>(reader, solver, threads, onResult);
+    }
+
+} //End namespace sudoku
@@ -0,0 +1,185 @@
+#include "sudoku/binary.hpp"
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+
+namespace sudoku {
+
+    namespace {
+        using traits = GridTraits<box_size>;
+
+        void writeLittle(uint8_t* out, uint64_t value, const int& bytes){
+            for (int i = 0; i < bytes; ++i){
+                out[i] = uint8_t(value >> (8*i));
+            }
+        }
+
+        uint64_t readLittle(const uint8_t* in, const int& bytes){
+            uint64_t value = 0;
+            for (int i = 0; i < bytes; ++i){
+                value |= uint64_t(in[i]) << (8*i);
+            }
+            return value;
+        }
+
+        std::size_t recordSizeFor(const bool& givens){
+            return packed_values_size + (givens ? packed_givens_size : 0);
+        }
+
+        void setValue(uint8_t* out, const int& index, const uint8_t& val){
+            out[index / 2] |= (index % 2 == 0) ? val : uint8_t(val << 4);
+        }
+    }
+
+    void packBoard(const Board& board, uint8_t* out, const bool& givens){
+        std::memset(out, 0, recordSizeFor(givens));
+        for (int i = 0; i < grid_size; ++i){
+            if (board[i].isBlank()){
+                continue;
+            }
+            setValue(out, i, board[i].getElement());
+            if (givens && board[i].isGiven()){
+                out[packed_values_size + i / 8] |= uint8_t(1u << (i % 8));
+            }
+        }
+    }
+
+    bool packPuzzle(std::string_view puzzle, uint8_t* out){
+        std::memset(out, 0, packed_values_size);
+        int squares = 0;
+        for (std::size_t i = 0; i < puzzle.size() && squares < grid_size; ++i){
+            char c = puzzle[i];
+            if (uint8_t val = traits::valueOf(c)){
+                setValue(out, squares++, val);
+            }
+            else if (c == blank_input_element_value || (c != '\0' && std::strchr(compact_blank_values, c))){
+                ++squares;
+            }
+        }
+        return squares == grid_size;
+    }
+
+    bool unpackBoard(const uint8_t* in, Board& board, const bool& givens){
+        //Values straight to given cells with one lookup per square, values past 9 become 0 so they can be caught
+        static constexpr std::array<uint8_t, 16> cell_table = [] {
+            std::array<uint8_t, 16> table{};
+            table[0] = blank_element_value;
+            for (int val = 1; val <= number_of_element_values; ++val){
+                table[val] = uint8_t(val | Board::given_bit);
+            }
+            return table;
+        }();
+
+        //Two squares per byte, the last byte only has one
+        uint8_t valid = 1;
+        for (std::size_t i = 0; i < grid_size / 2; ++i){
+            uint8_t low = cell_table[in[i] & 0xf], high = cell_table[in[i] >> 4];
+            board.cells[2*i] = low;
+            board.cells[2*i + 1] = high;
+            valid &= (low != 0) & (high != 0);
+        }
+        if constexpr (grid_size % 2 == 1){
+            board.cells[grid_size - 1] = cell_table[in[grid_size / 2] & 0xf];
+            valid &= board.cells[grid_size - 1] != 0;
+        }
+        if (givens){
+            const uint8_t* bitmap = in + packed_values_size;
+            for (int i = 0; i < grid_size; ++i){
+                if (!((bitmap[i / 8] >> (i % 8)) & 1)){
+                    board.cells[i] &= ~Board::given_bit;
+                }
+            }
+        }
+        board.possibles.fill(0);
+        return valid;
+    }
+
+    void appendBoardLine(const Board& board, std::string& out){
+        for (int i = 0; i < grid_size; ++i){
+            out.push_back(board[i].isBlank() ? blank_input_element_value : traits::symbolOf(board[i].getElement()));
+        }
+    }
+
+    BinaryWriter::BinaryWriter(std::ostream& out, const bool& givens) : out(out), givens(givens), record(recordSizeFor(givens), '\0') {
+        uint8_t header[binary_header_size] = {};
+        std::memcpy(header, binary_magic, 4);
+        header[4] = binary_version;
+        header[5] = box_size;
+        header[6] = givens ? binary_givens : 0;
+        start = out.tellp();
+        out.write(reinterpret_cast<const char*>(header), binary_header_size);
+    }
+
+    bool BinaryWriter::add(std::string_view puzzle){
+        if (givens){
+            //Text puzzles only have givens, so every value gets its bit
+            Board board;
+            uint8_t* values = reinterpret_cast<uint8_t*>(record.data());
+            if (!packPuzzle(puzzle, values) || !unpackBoard(values, board, false)){
+                return false;
+            }
+            add(board);
+            return true;
+        }
+        if (!packPuzzle(puzzle, reinterpret_cast<uint8_t*>(record.data()))){
+            return false;
+        }
+        out.write(record.data(), record.size());
+        ++count;
+        return true;
+    }
+
+    void BinaryWriter::add(const Board& board){
+        packBoard(board, reinterpret_cast<uint8_t*>(record.data()), givens);
+        out.write(record.data(), record.size());
+        ++count;
+    }
+
+    bool BinaryWriter::finish(){
+        uint8_t bytes[8];
+        writeLittle(bytes, count, 8);
+        std::streampos end = out.tellp();
+        out.seekp(start + std::streamoff(8));
+        out.write(reinterpret_cast<const char*>(bytes), 8);
+        out.seekp(end);
+        return bool(out.flush());
+    }
+
+    BinaryReader::BinaryReader(std::string_view data) : data(data) {
+        if (data.size() < binary_header_size || !isBinary(data)){
+            return;
+        }
+        const uint8_t* header = reinterpret_cast<const uint8_t*>(data.data());
+        givens = header[6] & binary_givens;
+        recordSize = recordSizeFor(givens);
+        count = readLittle(header + 8, 8);
+        valid = header[4] == binary_version && header[5] == box_size && count <= (data.size() - binary_header_size) / recordSize;
+        if (!valid){
+            count = 0;
+        }
+    }
+
+    bool BinaryReader::get(const std::size_t& k, Board& board) const{
+        if (k >= count){
+            return false;
+        }
+        return unpackBoard(reinterpret_cast<const uint8_t*>(data.data()) + binary_header_size + k*recordSize, board, givens);
+    }
+
+    bool BinaryReader::next(Board& board){
+        //A bad record is skipped like a line that is not a puzzle, but said so, position still counts it
+        while (position < count){
+            if (get(position++, board)){
+                return true;
+            }
+            printf("Error: Binary record %zu has a value out of range, skipped\n", position - 1);
+        }
+        return false;
+    }
+
+    bool BinaryReader::isBinary(std::string_view data){
+        return data.substr(0, 4) == std::string_view(binary_magic, 4);
+    }
+
+} //End namespace sudoku
@@ -0,0 +1,424 @@
+#include "sudoku/canonical.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace sudoku {
+
+    namespace {
+        constexpr int n = number_of_element_values;
+        constexpr uint8_t perms3[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+
+        //Values 0 to 9 of a grid, 0 for blank
+        using Values = std::array<uint8_t, grid_size>;
+
+        //One orientation still in the running: the rows picked so far, the digits numbered so far, and the columns
+        //Columns are only put in order as far as the rows picked so far tell them apart. Bit p of groups is set
+        //where a run of columns starts, columns in a run are blank in every picked row so any order of them ties
+        struct State {
+            bool transpose;
+            uint16_t usedRows;
+            uint16_t groups;
+            uint8_t nextLabel;
+            std::array<uint8_t, n> rows;
+            std::array<uint8_t, n> cols;
+            std::array<uint8_t, n + 1> relabel;
+        };
+
+        //Tied orientations for the row being picked, and the smallest row seen so far
+        struct Step {
+            std::vector<State> states;
+            uint64_t best = ~uint64_t(0);
+            std::size_t cap;
+            bool overflow = false;
+        };
+
+        //Columns in a run that got new digits, any order of them gives the same row but numbers the digits differently
+        struct FreshRun {
+            uint8_t start;
+            uint8_t size;
+            uint8_t label; //Number of the first digit in the run
+        };
+
+        uint8_t valueOf(const uint8_t& cell){
+            uint8_t val = cell & ~Board::given_bit;
+            return val == blank_element_value ? 0 : val;
+        }
+
+        void push(Step& step, const State& state){
+            if (step.states.size() == step.cap){
+                step.overflow = true;
+                return;
+            }
+            step.states.push_back(state);
+        }
+
+        //Adds state and every other order of the fresh runs from run on, numbering their digits to match
+        void pushOrders(Step& step, State& state, const Values& values, const uint8_t& row, const FreshRun* runs,
+            const int& run, const int& runCount){
+            if (run == runCount){
+                push(step, state);
+                return;
+            }
+            const FreshRun& fresh = runs[run];
+            uint8_t* cols = state.cols.data() + fresh.start;
+            std::sort(cols, cols + fresh.size);
+            do {
+                for (int k = 0; k < fresh.size; ++k){
+                    state.relabel[values[row*n + cols[k]]] = fresh.label + k;
+                }
+                pushOrders(step, state, values, row, runs, run + 1, runCount);
+            } while (std::next_permutation(cols, cols + fresh.size));
+        }
+
+        //Picks row as the next row of state, ordering each run of tied columns to make the row as small as it can be:
+        //blanks first, then digits already numbered, then new ones. Rows are compared as one number, 4 bits a square
+        //with the first square highest, so smaller is earlier in order
+        //Returns false if the row comes out over the best row so far, the state is left out then
+        bool extend(const State& state, const Values& values, const uint8_t& row, const uint8_t& depth, Step& step){
+            State child = state;
+            child.groups = 0;
+            const uint8_t* line = values.data() + row*n;
+            FreshRun runs[box_size];
+            int runCount = 0;
+            uint64_t code = 0;
+            for (int start = 0; start < n; ){
+                int end = start + 1;
+                while (end < n && !((state.groups >> end) & 1)){
+                    ++end;
+                }
+                //Runs never cross a stack, so they hold at most box_size columns
+                uint8_t blanks[box_size], known[box_size], fresh[box_size];
+                int blankCount = 0, knownCount = 0, freshCount = 0;
+                for (int p = start; p < end; ++p){
+                    uint8_t col = state.cols[p], val = line[col];
+                    if (val == 0){
+                        blanks[blankCount++] = col;
+                    }
+                    else if (state.relabel[val] != 0){
+                        //Insertion sort by number, there are only a few
+                        int k = knownCount++;
+                        for (; k > 0 && state.relabel[line[known[k - 1]]] > state.relabel[val]; --k){
+                            known[k] = known[k - 1];
+                        }
+                        known[k] = col;
+                    }
+                    else{
+                        fresh[freshCount++] = col;
+                    }
+                }
+
+                int p = start;
+                if (blankCount > 0){
+                    child.groups |= 1u << p;
+                }
+                for (int k = 0; k < blankCount; ++k){
+                    child.cols[p++] = blanks[k];
+                    code <<= 4;
+                }
+                for (int k = 0; k < knownCount; ++k){
+                    child.groups |= 1u << p;
+                    child.cols[p++] = known[k];
+                    code = (code << 4) | state.relabel[line[known[k]]];
+                }
+                if (freshCount > 1){
+                    runs[runCount++] = {uint8_t(p), uint8_t(freshCount), child.nextLabel};
+                }
+                for (int k = 0; k < freshCount; ++k){
+                    child.groups |= 1u << p;
+                    child.cols[p++] = fresh[k];
+                    child.relabel[line[fresh[k]]] = child.nextLabel;
+                    code = (code << 4) | child.nextLabel++;
+                }
+                if ((code << 4*(n - end)) > step.best){
+                    return false;
+                }
+                start = end;
+            }
+
+            if (code < step.best){
+                step.best = code;
+                step.states.clear();
+                step.overflow = false;
+            }
+            child.rows[depth] = row;
+            child.usedRows |= 1u << row;
+            pushOrders(step, child, values, row, runs, 0, runCount);
+            return true;
+        }
+
+        //Starts a search from row as the first row. Only the order of the stacks is picked here, the columns in each
+        //stack start as one run. The first row's digits are always numbered 1, 2, 3... so fewer digits go first
+        void firstRow(const Values& values, const bool& transpose, const uint8_t& row, Step& step){
+            std::array<int, box_size> counts{};
+            for (int c = 0; c < n; ++c){
+                counts[c / box_size] += values[row*n + c] != 0;
+            }
+            State state{transpose, 0, 0, 1, {}, {}, {}};
+            for (const auto& stacks : perms3){
+                if (counts[stacks[0]] > counts[stacks[1]] || counts[stacks[1]] > counts[stacks[2]]){
+                    continue;
+                }
+                for (int s = 0; s < box_size; ++s){
+                    state.groups |= 1u << (s*box_size);
+                    for (int k = 0; k < box_size; ++k){
+                        state.cols[s*box_size + k] = stacks[s]*box_size + k;
+                    }
+                }
+                //Every stack order here gives the same first row, so if one is over the best they all are
+                if (!extend(state, values, row, 0, step)){
+                    return;
+                }
+            }
+        }
+
+        //Relabels the digits by first appearance without moving anything, used when the search gives up
+        Transform relabelOnly(const Board& board){
+            Transform transform;
+            transform.relabel.fill(0);
+            uint8_t next = 1;
+            for (int i = 0; i < grid_size; ++i){
+                uint8_t val = valueOf(board.cells[i]);
+                if (val != 0 && transform.relabel[val] == 0){
+                    transform.relabel[val] = next++;
+                }
+            }
+            for (int val = 1; val <= n; ++val){
+                if (transform.relabel[val] == 0){
+                    transform.relabel[val] = next++;
+                }
+            }
+            return transform;
+        }
+
+        std::string keyOf(const Board& board){
+            std::string key(grid_size, '0');
+            for (int i = 0; i < grid_size; ++i){
+                key[i] = char('0' + valueOf(board.cells[i]));
+            }
+            return key;
+        }
+
+        //Reads a key or stored solution back into a board, returns false if it is not grid_size digits
+        bool boardOf(const std::string& key, Board& board){
+            if (key.size() != std::size_t(grid_size)){
+                return false;
+            }
+            board = Board();
+            for (int i = 0; i < grid_size; ++i){
+                if (key[i] < '0' || key[i] > '0' + n){
+                    return false;
+                }
+                board.cells[i] = key[i] == '0' ? blank_element_value : uint8_t(key[i] - '0');
+            }
+            return true;
+        }
+    }
+
+    CanonicalForm canonicalize(const Board& board, const std::size_t& stateCap){
+        //Both orientations up front so rows can be read straight across either way
+        std::array<Values, 2> values;
+        for (int i = 0; i < grid_size; ++i){
+            values[0][i] = valueOf(board.cells[i]);
+            values[1][colOf(i)*n + rowOf(i)] = values[0][i];
+        }
+
+        std::size_t cap = stateCap;
+        if (std::find(values[0].begin(), values[0].end(), 0) == values[0].end()){
+            cap = std::max(cap, canonical_solved_state_cap);
+        }
+
+        Step step;
+        step.cap = cap;
+        for (int t = 0; t < 2; ++t){
+            for (uint8_t row = 0; row < n; ++row){
+                firstRow(values[t], t == 1, row, step);
+            }
+        }
+        //The rest of each band comes next, then any row of a band not used yet
+        for (uint8_t depth = 1; depth < n && !step.overflow; ++depth){
+            Step next;
+            next.cap = cap;
+            next.states.reserve(step.states.size());
+            for (const State& state : step.states){
+                const Values& grid = values[state.transpose];
+                if (depth % box_size != 0){
+                    uint8_t band = state.rows[depth - 1] / box_size;
+                    for (uint8_t row = band*box_size; row < (band + 1)*box_size; ++row){
+                        if (!(state.usedRows & (1u << row))){
+                            extend(state, grid, row, depth, next);
+                        }
+                    }
+                }
+                else{
+                    for (uint8_t row = 0; row < n; row += box_size){
+                        if (((state.usedRows >> row) & ((1u << box_size) - 1)) == 0){
+                            for (uint8_t r = row; r < row + box_size; ++r){
+                                extend(state, grid, r, depth, next);
+                            }
+                        }
+                    }
+                }
+            }
+            step = std::move(next);
+        }
+
+        CanonicalForm form;
+        if (step.overflow){
+            form.transform = relabelOnly(board);
+        }
+        else{
+            //Every state left gives the same grid, any of them will do
+            const State& best = step.states.front();
+            form.transform.transpose = best.transpose;
+            form.transform.rows = best.rows;
+            form.transform.cols = best.cols;
+            form.transform.relabel = best.relabel;
+            uint8_t next = best.nextLabel;
+            for (int val = 1; val <= n; ++val){
+                if (form.transform.relabel[val] == 0){
+                    form.transform.relabel[val] = next++;
+                }
+            }
+            form.exact = true;
+        }
+        form.key = keyOf(applyTransform(board, form.transform));
+        return form;
+    }
+
+    Board applyTransform(const Board& board, const Transform& transform){
+        Board out;
+        for (uint8_t i = 0; i < grid_size; ++i){
+            uint8_t cell = board.cells[transform.sourceOf(i)];
+            uint8_t val = valueOf(cell);
+            out.cells[i] = val == 0 ? blank_element_value : uint8_t(transform.relabel[val] | (cell & Board::given_bit));
+        }
+        return out;
+    }
+
+    Board invertTransform(const Board& board, const Transform& transform){
+        std::array<uint8_t, n + 1> original{};
+        for (int val = 1; val <= n; ++val){
+            original[transform.relabel[val]] = val;
+        }
+        Board out;
+        for (uint8_t i = 0; i < grid_size; ++i){
+            uint8_t cell = board.cells[i];
+            uint8_t val = valueOf(cell);
+            out.cells[transform.sourceOf(i)] = val == 0 ? blank_element_value : uint8_t(original[val] | (cell & Board::given_bit));
+        }
+        return out;
+    }
+
+    SolutionCache::SolutionCache(const std::size_t& capacity, const SolveMethod& solver) : capacity(capacity) {
+        sudoku.setSolverType(solver);
+    }
+
+    std::string* SolutionCache::lookup(const std::string& key){
+        auto found = index.find(key);
+        if (found == index.end()){
+            return nullptr;
+        }
+        entries.splice(entries.begin(), entries, found->second);
+        return &found->second->second;
+    }
+
+    void SolutionCache::insert(const std::string& key, std::string solution){
+        if (std::string* cached = lookup(key)){
+            *cached = std::move(solution);
+            return;
+        }
+        if (capacity == 0){
+            return;
+        }
+        entries.emplace_front(key, std::move(solution));
+        index.emplace(key, entries.begin());
+        if (index.size() > capacity){
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+
+    bool SolutionCache::restore(const std::string& stored, const Board& puzzle, const Transform& transform, Board& solution) const{
+        Board canonical;
+        if (!boardOf(stored, canonical)){
+            return false;
+        }
+        //Stored solutions have no givens, take them from the puzzle
+        solution = invertTransform(canonical, transform);
+        for (int i = 0; i < grid_size; ++i){
+            solution.cells[i] |= puzzle.cells[i] & Board::given_bit;
+        }
+        return true;
+    }
+
+    bool SolutionCache::find(const Board& puzzle, Board& solution, bool& solvable){
+        CanonicalForm form = canonicalize(puzzle);
+        const std::string* cached = lookup(form.key);
+        if (cached == nullptr){
+            ++misses;
+            return false;
+        }
+        ++hits;
+        solvable = restore(*cached, puzzle, form.transform, solution);
+        return true;
+    }
+
+    bool SolutionCache::solve(const Board& puzzle, Board& solution){
+        CanonicalForm form = canonicalize(puzzle);
+        if (const std::string* cached = lookup(form.key)){
+            ++hits;
+            return restore(*cached, puzzle, form.transform, solution);
+        }
+        ++misses;
+        bool solvable = sudoku.load(puzzle) && sudoku.solve();
+        std::string stored;
+        if (solvable){
+            solution = sudoku.getBoard();
+            stored = keyOf(applyTransform(solution, form.transform));
+        }
+        insert(form.key, std::move(stored));
+        return solvable;
+    }
+
+    void SolutionCache::clear(){
+        entries.clear();
+        index.clear();
+        hits = 0;
+        misses = 0;
+    }
+
+    bool SolutionCache::save(const std::string& path) const{
+        std::ofstream out(path);
+        if (!out.is_open()){
+            printf("Error: could not create file %s\n", path.c_str());
+            return false;
+        }
+        for (auto entry = entries.rbegin(); entry != entries.rend(); ++entry){
+            out << entry->first << ' ' << (entry->second.empty() ? "-" : entry->second) << '\n';
+        }
+        return bool(out.flush());
+    }
+
+    bool SolutionCache::load(const std::string& path){
+        std::ifstream in(path);
+        if (!in.is_open()){
+            return false;
+        }
+        std::string key, solution;
+        Board board;
+        while (in >> key >> solution){
+            if (solution == "-"){
+                solution.clear();
+            }
+            //Lines that are not a key and a whole solution are skipped
+            if (!boardOf(key, board) || (!solution.empty() && !boardOf(solution, board))){
+                continue;
+            }
+            insert(key, solution);
+        }
+        return true;
+    }
+
+} //End namespace sudoku
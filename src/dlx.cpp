@@ -0,0 +1,180 @@
+#include "sudoku/dlx.hpp"
+
+#include <algorithm>
+
+namespace sudoku {
+
+    template <int BoxSize>
+    BasicDancingLinks<BoxSize>::BasicDancingLinks() : nodes(first_row_node + rows*dlx_constraints) {}
+
+    template <int BoxSize>
+    bool BasicDancingLinks<BoxSize>::load(const Board& grid){
+        depth = 0;
+        steps = 0;
+        backtracks = 0;
+        maxDepth = 0;
+        solved = false;
+        stopped = SOLVED;
+
+        //Column headers are a circular list hung off the root
+        for (uint16_t c = 0; c <= columns; ++c){
+            nodes[c] = {uint16_t(c == 0 ? columns : c - 1), uint16_t(c == columns ? 0 : c + 1), c, c, c, 0};
+            sizes[c] = 0;
+            covered[c] = false;
+        }
+
+        //Each row covers its square, and its value in the row, column, and box
+        for (uint16_t r = 0; r < rows; ++r){
+            uint16_t index = r / number_of_element_values;
+            uint8_t val = r % number_of_element_values;
+            std::array<uint16_t, dlx_constraints> constraints = {
+                uint16_t(1 + index),
+                uint16_t(1 + grid_size + traits::rowOf(index)*number_of_element_values + val),
+                uint16_t(1 + 2*grid_size + traits::colOf(index)*number_of_element_values + val),
+                uint16_t(1 + 3*grid_size + traits::boxOf(index)*number_of_element_values + val)
+            };
+            uint16_t base = first_row_node + r*dlx_constraints;
+            for (uint8_t k = 0; k < dlx_constraints; ++k){
+                uint16_t node = base + k;
+                uint16_t column = constraints[k];
+                nodes[node].left = base + (k + dlx_constraints - 1) % dlx_constraints;
+                nodes[node].right = base + (k + 1) % dlx_constraints;
+                nodes[node].column = column;
+                nodes[node].row = r;
+                //Append to the bottom of the column
+                nodes[node].up = nodes[column].up;
+                nodes[node].down = column;
+                nodes[nodes[column].up].down = node;
+                nodes[column].up = node;
+                ++sizes[column];
+            }
+        }
+
+        //Givens are rows that must be picked, cover their columns up front
+        for (uint16_t i = 0; i < grid_size; ++i){
+            if (grid[i].isBlank()){
+                continue;
+            }
+            uint16_t base = first_row_node + (i*number_of_element_values + grid[i].getElement() - 1)*dlx_constraints;
+            for (uint8_t k = 0; k < dlx_constraints; ++k){
+                if (covered[nodes[base + k].column]){
+                    return false;
+                }
+            }
+            for (uint8_t k = 0; k < dlx_constraints; ++k){
+                cover(nodes[base + k].column);
+            }
+            picked[depth++] = nodes[base].row;
+        }
+        givens = depth;
+        return true;
+    }
+
+    template <int BoxSize>
+    void BasicDancingLinks<BoxSize>::cover(const uint16_t& column){
+        covered[column] = true;
+        nodes[nodes[column].right].left = nodes[column].left;
+        nodes[nodes[column].left].right = nodes[column].right;
+        for (uint16_t i = nodes[column].down; i != column; i = nodes[i].down){
+            for (uint16_t j = nodes[i].right; j != i; j = nodes[j].right){
+                nodes[nodes[j].down].up = nodes[j].up;
+                nodes[nodes[j].up].down = nodes[j].down;
+                --sizes[nodes[j].column];
+            }
+        }
+    }
+
+    template <int BoxSize>
+    void BasicDancingLinks<BoxSize>::uncover(const uint16_t& column){
+        for (uint16_t i = nodes[column].up; i != column; i = nodes[i].up){
+            for (uint16_t j = nodes[i].left; j != i; j = nodes[j].left){
+                ++sizes[nodes[j].column];
+                nodes[nodes[j].down].up = j;
+                nodes[nodes[j].up].down = j;
+            }
+        }
+        nodes[nodes[column].right].left = column;
+        nodes[nodes[column].left].right = column;
+        covered[column] = false;
+    }
+
+    template <int BoxSize>
+    bool BasicDancingLinks<BoxSize>::search(){
+        if (limits != nullptr && (stopped = limits->check(steps + 1)) != SOLVED){
+            return false;
+        }
+        ++steps;
+        maxDepth = std::max<uint16_t>(maxDepth, depth - givens);
+        if (nodes[root].right == root){
+            return true;
+        }
+
+        //Branch on the column with the fewest rows left
+        uint16_t column = nodes[root].right;
+        for (uint16_t c = nodes[column].right; c != root && sizes[column] > 1; c = nodes[c].right){
+            if (sizes[c] < sizes[column]){
+                column = c;
+            }
+        }
+        if (sizes[column] == 0){
+            return false;
+        }
+
+        cover(column);
+        for (uint16_t r = nodes[column].down; r != column; r = nodes[r].down){
+            picked[depth++] = nodes[r].row;
+            for (uint16_t j = nodes[r].right; j != r; j = nodes[j].right){
+                cover(nodes[j].column);
+            }
+            if (search()){
+                return true;
+            }
+            for (uint16_t j = nodes[r].left; j != r; j = nodes[j].left){
+                uncover(nodes[j].column);
+            }
+            --depth;
+            //Hit a limit, unwind without trying the other rows
+            if (stopped != SOLVED){
+                break;
+            }
+            ++backtracks;
+        }
+        uncover(column);
+        return false;
+    }
+
+    template <int BoxSize>
+    bool BasicDancingLinks<BoxSize>::solve(){
+        solved = search();
+        return solved;
+    }
+
+    template <int BoxSize>
+    SolveStatus BasicDancingLinks<BoxSize>::solve(const SolveLimits& limits){
+        this->limits = &limits;
+        stopped = SOLVED;
+        solve();
+        this->limits = nullptr;
+        return solved ? SOLVED : stopped == SOLVED ? NO_SOLUTION : stopped;
+    }
+
+    template <int BoxSize>
+    bool BasicDancingLinks<BoxSize>::writeSolution(Board& grid) const {
+        if (!solved){
+            return false;
+        }
+        for (uint16_t k = 0; k < depth; ++k){
+            uint16_t index = picked[k] / number_of_element_values;
+            if (grid[index].isBlank()){
+                grid[index].setElement(picked[k] % number_of_element_values + 1);
+            }
+        }
+        return true;
+    }
+
+    template class BasicDancingLinks<2>;
+    template class BasicDancingLinks<3>;
+    template class BasicDancingLinks<4>;
+    template class BasicDancingLinks<5>;
+
+} //End namespace sudoku
@@ -0,0 +1,99 @@
+#include "sudoku/generator.hpp"
+#include "sudoku/parallel.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace sudoku {
+
+    namespace {
+        //Spreads (seed, k) over the whole 64 bits so neighbouring puzzles get unrelated streams
+        uint64_t mixSeed(uint64_t value){
+            value += 0x9e3779b97f4a7c15ull;
+            value = (value ^ (value >> 30))*0xbf58476d1ce4e5b9ull;
+            value = (value ^ (value >> 27))*0x94d049bb133111ebull;
+            return value ^ (value >> 31);
+        }
+    }
+
+    Generator::Generator(const uint64_t& seed) : random(seed) {
+        sudoku.setSolverType(HYBRID);
+    }
+
+    Board Generator::fillGrid(){
+        std::array<uint8_t, number_of_element_values> values;
+        std::iota(values.begin(), values.end(), 1);
+        while (true){
+            Board board;
+            for (int box = 0; box < box_size; ++box){
+                std::shuffle(values.begin(), values.end(), random);
+                for (int k = 0; k < number_of_element_values; ++k){
+                    int row = box*box_size + k / box_size, col = box*box_size + k % box_size;
+                    board.cells[row*number_of_element_values + col] = values[k];
+                }
+            }
+            if (sudoku.load(board) && sudoku.solve()){
+                Board grid = sudoku.getBoard();
+                for (uint8_t& cell : grid.cells){
+                    cell |= Board::given_bit;
+                }
+                grid.possibles.fill(0);
+                return grid;
+            }
+        }
+    }
+
+    bool Generator::keeps(const Board& puzzle, const Difficulty& target, Difficulty& grade){
+        sudoku.load(puzzle);
+        //Anything goes for the hardest grade, so it only needs the count, graded once at the end
+        if (target == EXPERT){
+            grade = EXPERT;
+            return sudoku.countSolutions(2) == 1;
+        }
+        grade = sudoku.grade();
+        //Rules only make deductions every solution shares, so a puzzle they finish has one solution
+        return grade <= target;
+    }
+
+    bool Generator::generate(const Difficulty& target, Board& puzzle){
+        std::array<uint8_t, grid_size> order;
+        std::iota(order.begin(), order.end(), 0);
+        for (int attempt = 0; attempt < max_generate_attempts; ++attempt){
+            puzzle = fillGrid();
+            std::shuffle(order.begin(), order.end(), random);
+            Difficulty grade = EASY;
+            for (uint8_t index : order){
+                uint8_t cell = puzzle.cells[index];
+                puzzle.cells[index] = blank_element_value;
+                Difficulty removed;
+                if (keeps(puzzle, target, removed)){
+                    grade = removed;
+                }
+                else{
+                    puzzle.cells[index] = cell;
+                }
+            }
+            if (target == EXPERT){
+                sudoku.load(puzzle);
+                grade = sudoku.grade();
+            }
+            if (grade == target){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<Board> generatePuzzles(const std::size_t& count, const Difficulty& target, const uint64_t& seed,
+        const unsigned int& threads){
+        std::vector<Board> puzzles(count);
+        parallelFor(count, threads == 0 ? defaultWorkers() : threads, [&] (unsigned int, std::size_t k){
+            Generator generator(mixSeed(seed ^ mixSeed(k)));
+            if (!generator.generate(target, puzzles[k])){
+                puzzles[k] = Board();
+            }
+        });
+        return puzzles;
+    }
+
+} //End namespace sudoku
@@ -0,0 +1,121 @@
+#include "sudoku/loader.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SUDOKU_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sudoku {
+
+    namespace {
+        //1 for every char Sudoku::load reads as a square of a 9x9 grid, so a line is counted with one lookup per char
+        constexpr std::array<uint8_t, 256> makeSquareTable(){
+            std::array<uint8_t, 256> table{};
+            for (int c = 0; c < 256; ++c){
+                table[c] = GridTraits<box_size>::symbol_table[c] != 0;
+            }
+            table[uint8_t(blank_input_element_value)] = 1;
+            for (const char* c = compact_blank_values; *c != '\0'; ++c){
+                table[uint8_t(*c)] = 1;
+            }
+            return table;
+        }
+        constexpr std::array<uint8_t, 256> square_table = makeSquareTable();
+    }
+
+    MappedFile::MappedFile(const std::string& path){
+#if defined(SUDOKU_MMAP)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1){
+            return;
+        }
+        struct stat info;
+        if (fstat(fd, &info) == 0){
+            open = true;
+            size = std::size_t(info.st_size);
+            //Mapping 0 bytes fails, an empty file just has an empty view
+            if (size > 0){
+                void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (address != MAP_FAILED){
+                    madvise(address, size, MADV_SEQUENTIAL);
+                    data = static_cast<const char*>(address);
+                    mapped = true;
+                }
+                else{
+                    open = false;
+                    size = 0;
+                }
+            }
+        }
+        ::close(fd);
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()){
+            return;
+        }
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data = buffer.data();
+        size = buffer.size();
+        open = true;
+#endif
+    }
+
+    MappedFile::~MappedFile(){
+#if defined(SUDOKU_MMAP)
+        if (mapped){
+            munmap(const_cast<char*>(data), size);
+        }
+#endif
+    }
+
+    bool PuzzleScanner::next(std::string_view& record){
+        //Where the grid being put together started, and how many of its squares have been seen
+        std::size_t gridStart = 0;
+        std::size_t squares = 0;
+        while (pos < data.size()){
+            std::size_t lineStart = pos;
+            const void* newline = std::memchr(data.data() + pos, '\n', data.size() - pos);
+            std::size_t lineEnd = newline ? static_cast<const char*>(newline) - data.data() : data.size();
+            pos = newline ? lineEnd + 1 : data.size();
+
+            std::size_t lineSquares = 0;
+            for (std::size_t i = lineStart; i < lineEnd; ++i){
+                lineSquares += square_table[uint8_t(data[i])];
+            }
+
+            //Same rules as PuzzleReader, a whole puzzle on one line replaces any unfinished grid
+            if (lineSquares == grid_size){
+                record = data.substr(lineStart, lineEnd - lineStart);
+                ++count;
+                return true;
+            }
+            if (lineSquares == number_of_element_values && squares + lineSquares <= grid_size){
+                if (squares == 0){
+                    gridStart = lineStart;
+                }
+                squares += lineSquares;
+                if (squares == grid_size){
+                    //Titles and decorations between the rows have no squares, so load skips them
+                    record = data.substr(gridStart, lineEnd - gridStart);
+                    ++count;
+                    return true;
+                }
+                continue;
+            }
+            //Lines without squares leave the grid alone, anything else breaks it up
+            if (lineSquares != 0){
+                squares = 0;
+            }
+        }
+        return false;
+    }
+
+} //End namespace sudoku
@@ -0,0 +1,103 @@
+#include "sudoku/parallel.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sudoku {
+
+    namespace {
+        //Items [begin, end) still waiting on one worker
+        struct WorkRange {
+            std::mutex lock;
+            std::size_t begin = 0;
+            std::size_t end = 0;
+        };
+
+        bool takeOwn(WorkRange& range, std::size_t& item){
+            std::lock_guard<std::mutex> guard(range.lock);
+            if (range.begin == range.end){
+                return false;
+            }
+            item = range.begin++;
+            return true;
+        }
+
+        //Moves the back half of the fullest other range into mine, returns false once everything is taken
+        bool steal(std::vector<std::unique_ptr<WorkRange>>& ranges, const unsigned int& thief){
+            while (true){
+                unsigned int victim = thief;
+                std::size_t most = 0;
+                for (unsigned int i = 0; i < ranges.size(); ++i){
+                    std::lock_guard<std::mutex> guard(ranges[i]->lock);
+                    if (i != thief && ranges[i]->end - ranges[i]->begin > most){
+                        most = ranges[i]->end - ranges[i]->begin;
+                        victim = i;
+                    }
+                }
+                if (most == 0){
+                    return false;
+                }
+
+                //Lock in index order so two thieves can't deadlock
+                WorkRange& from = *ranges[victim];
+                WorkRange& to = *ranges[thief];
+                std::unique_lock<std::mutex> first(victim < thief ? from.lock : to.lock);
+                std::unique_lock<std::mutex> second(victim < thief ? to.lock : from.lock);
+                std::size_t left = from.end - from.begin;
+                if (left == 0){
+                    //Someone else got there first, look again
+                    continue;
+                }
+                std::size_t half = (left + 1) / 2;
+                to.begin = from.end - half;
+                to.end = from.end;
+                from.end -= half;
+                return true;
+            }
+        }
+    }
+
+    unsigned int defaultWorkers(){
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    void parallelFor(const std::size_t& count, const unsigned int& workers,
+        const std::function<void(unsigned int, std::size_t)>& task){
+        unsigned int threads = std::max(1u, std::min<unsigned int>(workers, std::max<std::size_t>(count, 1)));
+        if (threads == 1){
+            for (std::size_t i = 0; i < count; ++i){
+                task(0, i);
+            }
+            return;
+        }
+
+        std::vector<std::unique_ptr<WorkRange>> ranges;
+        for (unsigned int w = 0; w < threads; ++w){
+            ranges.push_back(std::make_unique<WorkRange>());
+            ranges[w]->begin = count*w / threads;
+            ranges[w]->end = count*(w + 1) / threads;
+        }
+
+        auto work = [&ranges, &task] (unsigned int worker){
+            std::size_t item;
+            do {
+                while (takeOwn(*ranges[worker], item)){
+                    task(worker, item);
+                }
+            } while (steal(ranges, worker));
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned int w = 1; w < threads; ++w){
+            pool.emplace_back(work, w);
+        }
+        work(0);
+        for (std::thread& t : pool){
+            t.join();
+        }
+    }
+
+} //End namespace sudoku
@@ -0,0 +1,469 @@
+#include "sudoku/service.hpp"
+#include "sudoku/parallel.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SUDOKU_SOCKETS 1
+#include <cerrno>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace sudoku {
+
+    namespace {
+        //Answer status for each SolveStatus, PAUSED never comes out of solve()
+        const char* status_names[] = {"solved", "unsolvable", "paused", "node_limit", "timeout", "cancelled"};
+
+        bool isPuzzle(std::string_view token){
+            if (token.size() != grid_size){
+                return false;
+            }
+            for (char c : token){
+                if (GridTraits<box_size>::valueOf(c) == 0 && c != blank_input_element_value
+                    && c != compact_blank_values[0] && c != compact_blank_values[1]){
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        //Reads the number after prefix in token, returns false if token is not prefix and a whole number
+        template <typename T>
+        bool readOption(std::string_view token, std::string_view prefix, T& value){
+            if (token.substr(0, prefix.size()) != prefix){
+                return false;
+            }
+            const char* first = token.data() + prefix.size();
+            const char* last = token.data() + token.size();
+            auto [end, error] = std::from_chars(first, last, value);
+            return first != last && end == last && error == std::errc();
+        }
+
+        //Appends " name=value" without a temporary string
+        void appendStat(std::string& out, const char* name, const uint64_t& value){
+            char digits[24];
+            auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+            out.append(" ").append(name).append("=").append(digits, end);
+        }
+
+#if defined(SUDOKU_SOCKETS)
+        //Writes all of data, returns false once the other end has gone
+        bool sendAll(const int& fd, std::string_view data){
+#if defined(MSG_NOSIGNAL)
+            const int flags = MSG_NOSIGNAL;
+#else
+            const int flags = 0;
+#endif
+            while (!data.empty()){
+                ssize_t sent = ::send(fd, data.data(), data.size(), flags);
+                if (sent < 0 && errno == EINTR){
+                    continue;
+                }
+                if (sent <= 0){
+                    return false;
+                }
+                data.remove_prefix(std::size_t(sent));
+            }
+            return true;
+        }
+#endif
+    }
+
+    std::string answerRequest(std::string_view request, Sudoku& sudoku, const ServiceConfig& config,
+        const std::atomic<bool>* cancel){
+        //Lines may end in \r\n
+        if (!request.empty() && request.back() == '\r'){
+            request.remove_suffix(1);
+        }
+        //Options first, the puzzle is always the last token, so each token is only read as an option once
+        //another one follows it. Nothing is allocated but the answer
+        SolveMethod method = config.method;
+        unsigned int timeLimitMs = config.timeLimitMs;
+        SolveLimits limits;
+        limits.cancel = cancel;
+        std::string_view puzzle;
+        for (std::size_t pos = 0; pos < request.size(); ){
+            std::size_t end = std::min(request.find(' ', pos), request.size());
+            std::string_view token = request.substr(pos, end - pos);
+            pos = end + 1;
+            if (token.empty()){
+                continue;
+            }
+            std::swap(token, puzzle);
+            if (token.empty()){
+                continue;
+            }
+            if (token == "backtrack"){
+                method = BACKTRACK;
+            }
+            else if (token == "rules"){
+                method = RULES;
+            }
+            else if (token == "hybrid"){
+                method = HYBRID;
+            }
+            else if (token == "dlx"){
+                method = DLX;
+            }
+            else if (!readOption(token, "ms=", timeLimitMs) && !readOption(token, "nodes=", limits.maxNodes)){
+                return "error unknown option " + std::string(token);
+            }
+        }
+        if (puzzle.empty()){
+            return "error empty request";
+        }
+        if (!isPuzzle(puzzle)){
+            return "error expected a puzzle of " + std::to_string(grid_size) + " squares";
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (timeLimitMs != 0){
+            limits.deadline = start + std::chrono::milliseconds(timeLimitMs);
+        }
+        sudoku.setSolverType(method);
+        std::string answer;
+        answer.reserve(grid_size + 64);
+        SolveStatus status = NO_SOLUTION;
+        if (!sudoku.load(puzzle)){
+            answer = "invalid";
+        }
+        else{
+            status = sudoku.solve(limits);
+            answer = status == NO_SOLUTION && method == RULES ? "stuck" : status_names[status];
+        }
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        answer.push_back(' ');
+        if (status == SOLVED){
+            sudoku.appendLine(answer);
+        }
+        else{
+            answer.append(puzzle);
+        }
+        appendStat(answer, "nodes", sudoku.getSteps());
+        appendStat(answer, "us", uint64_t(micros));
+        return answer;
+    }
+
+    SolverPool::SolverPool(const unsigned int& workers){
+        for (unsigned int w = 0; w < std::max(1u, workers); ++w){
+            threads.emplace_back(&SolverPool::work, this);
+        }
+    }
+
+    SolverPool::~SolverPool(){
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (std::thread& thread : threads){
+            thread.join();
+        }
+    }
+
+    void SolverPool::submit(Task task){
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            tasks.push_back(std::move(task));
+        }
+        ready.notify_one();
+    }
+
+    void SolverPool::work(){
+        //Kept for the life of the thread, so its buffers are reused by every task
+        Sudoku sudoku;
+        while (true){
+            Task task;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                ready.wait(guard, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()){
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task(sudoku);
+        }
+    }
+
+    //One client, the reader thread queues its requests and the writer sends the answers back in order
+    struct SolverService::Connection {
+        //Answers are only ever added at the back and taken from the front, so references to them stay valid
+        struct Answer {
+            std::string text;
+            bool done = false;
+        };
+
+        int fd = -1;
+        std::thread reader;
+        std::thread writer;
+        std::mutex lock;
+        std::condition_variable changed;
+        std::deque<Answer> answers;
+        bool closed = false; //No more requests are coming
+        bool broken = false; //The client stopped reading
+        std::atomic<bool> finished{false};
+    };
+
+    SolverService::SolverService(const ServiceConfig& config) : config(config) {}
+
+    bool SolverService::start(const std::string& address){
+#if !defined(SUDOKU_SOCKETS)
+        printf("Error: the solver service needs POSIX sockets\n");
+        return false;
+#else
+        if (acceptor.joinable()){
+            printf("Error: the solver service is already running\n");
+            return false;
+        }
+
+        const std::string tcp_prefix = "tcp:";
+        if (address.compare(0, tcp_prefix.size(), tcp_prefix) == 0){
+            std::string_view digits = std::string_view(address).substr(tcp_prefix.size());
+            unsigned int requested = 0;
+            if (!readOption(digits, "", requested) || requested > UINT16_MAX){
+                printf("Error: %s is not a valid port\n", address.c_str());
+                return false;
+            }
+            sockaddr_in local{};
+            local.sin_family = AF_INET;
+            local.sin_port = htons(uint16_t(requested));
+            local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            listener = ::socket(AF_INET, SOCK_STREAM, 0);
+            int reuse = 1;
+            setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            socklen_t length = sizeof(local);
+            if (listener == -1 || ::bind(listener, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0
+                || getsockname(listener, reinterpret_cast<sockaddr*>(&local), &length) != 0){
+                printf("Error: could not listen on %s: %s\n", address.c_str(), strerror(errno));
+                stop();
+                return false;
+            }
+            port = ntohs(local.sin_port);
+        }
+        else{
+            sockaddr_un local{};
+            local.sun_family = AF_UNIX;
+            if (address.empty() || address.size() >= sizeof(local.sun_path)){
+                printf("Error: %s is not a valid socket path\n", address.c_str());
+                return false;
+            }
+            memcpy(local.sun_path, address.c_str(), address.size() + 1);
+            ::unlink(address.c_str());
+            listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (listener == -1 || ::bind(listener, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0){
+                printf("Error: could not listen on %s: %s\n", address.c_str(), strerror(errno));
+                stop();
+                return false;
+            }
+            unixPath = address;
+        }
+        if (::listen(listener, SOMAXCONN) != 0 || ::pipe(wake) != 0){
+            printf("Error: could not listen on %s: %s\n", address.c_str(), strerror(errno));
+            stop();
+            return false;
+        }
+
+        cancel = false;
+        pool = std::make_unique<SolverPool>(config.workers == 0 ? defaultWorkers() : config.workers);
+        acceptor = std::thread(&SolverService::acceptLoop, this);
+        return true;
+#endif
+    }
+
+    void SolverService::stop(){
+#if defined(SUDOKU_SOCKETS)
+        if (acceptor.joinable()){
+            cancel = true;
+            char byte = 0;
+            while (::write(wake[1], &byte, 1) == -1 && errno == EINTR){}
+            acceptor.join();
+        }
+        //Closing the read side ends every connection once the answers it is waiting on are in
+        {
+            std::lock_guard<std::mutex> guard(connectionsLock);
+            for (const std::shared_ptr<Connection>& connection : connections){
+                std::lock_guard<std::mutex> connectionGuard(connection->lock);
+                if (connection->fd != -1){
+                    ::shutdown(connection->fd, SHUT_RDWR);
+                }
+            }
+        }
+        for (const std::shared_ptr<Connection>& connection : connections){
+            connection->reader.join();
+            connection->writer.join();
+        }
+        connections.clear();
+        pool.reset();
+
+        for (int* fd : {&listener, &wake[0], &wake[1]}){
+            if (*fd != -1){
+                ::close(*fd);
+                *fd = -1;
+            }
+        }
+        if (!unixPath.empty()){
+            ::unlink(unixPath.c_str());
+            unixPath.clear();
+        }
+        port = 0;
+#endif
+    }
+
+    void SolverService::acceptLoop(){
+#if defined(SUDOKU_SOCKETS)
+        while (true){
+            pollfd waiting[2] = {{listener, POLLIN, 0}, {wake[0], POLLIN, 0}};
+            if (::poll(waiting, 2, -1) < 0){
+                if (errno == EINTR){
+                    continue;
+                }
+                printf("Error: solver service stopped accepting: %s\n", strerror(errno));
+                return;
+            }
+            if (waiting[1].revents != 0){
+                return;
+            }
+            int fd = ::accept(listener, nullptr, nullptr);
+            if (fd == -1){
+                continue;
+            }
+            //Answers go out as soon as they are ready, not held back to fill a packet
+            if (unixPath.empty()){
+                int noDelay = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+            }
+#if defined(SO_NOSIGPIPE)
+            int noSignal = 1;
+            setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof(noSignal));
+#endif
+            reap();
+            auto connection = std::make_shared<Connection>();
+            connection->fd = fd;
+            connection->reader = std::thread(&SolverService::serve, this, connection);
+            connection->writer = std::thread(&SolverService::reply, this, connection);
+            std::lock_guard<std::mutex> guard(connectionsLock);
+            connections.push_back(connection);
+        }
+#endif
+    }
+
+    void SolverService::serve(const std::shared_ptr<Connection>& connection){
+#if defined(SUDOKU_SOCKETS)
+        Connection& c = *connection;
+        //Queues one request, waiting while the connection already has maxPipelined in flight
+        auto submit = [this, &connection, &c] (std::string_view line){
+            std::unique_lock<std::mutex> guard(c.lock);
+            c.changed.wait(guard, [this, &c] { return c.answers.size() < config.maxPipelined || c.broken; });
+            if (c.broken){
+                return false;
+            }
+            Connection::Answer& answer = c.answers.emplace_back();
+            guard.unlock();
+            pool->submit([this, connection, &answer, request = std::string(line)] (Sudoku& sudoku){
+                std::string text = answerRequest(request, sudoku, config, &cancel);
+                ++answered;
+                std::lock_guard<std::mutex> answerGuard(connection->lock);
+                answer.text = std::move(text);
+                answer.done = true;
+                connection->changed.notify_all();
+            });
+            return true;
+        };
+
+        std::string buffer;
+        char chunk[1 << 14];
+        bool reading = true;
+        while (reading){
+            ssize_t received = ::recv(c.fd, chunk, sizeof(chunk), 0);
+            if (received < 0 && errno == EINTR){
+                continue;
+            }
+            if (received <= 0){
+                //A last request with no newline still counts
+                if (!buffer.empty()){
+                    submit(buffer);
+                }
+                break;
+            }
+            buffer.append(chunk, std::size_t(received));
+            std::size_t start = 0;
+            for (std::size_t end; reading && (end = buffer.find('\n', start)) != std::string::npos; start = end + 1){
+                reading = submit(std::string_view(buffer).substr(start, end - start));
+            }
+            buffer.erase(0, start);
+            if (buffer.size() > service_max_line){
+                break;
+            }
+        }
+
+        std::lock_guard<std::mutex> guard(c.lock);
+        c.closed = true;
+        c.changed.notify_all();
+#endif
+    }
+
+    void SolverService::reply(const std::shared_ptr<Connection>& connection){
+#if defined(SUDOKU_SOCKETS)
+        Connection& c = *connection;
+        std::string out;
+        while (true){
+            {
+                std::unique_lock<std::mutex> guard(c.lock);
+                c.changed.wait(guard, [&c] { return (!c.answers.empty() && c.answers.front().done) || (c.closed && c.answers.empty()); });
+                if (c.answers.empty()){
+                    break;
+                }
+                //Everything ready goes out in one send, a pipelining client gets its answers in blocks
+                while (!c.answers.empty() && c.answers.front().done){
+                    out.append(c.answers.front().text).push_back('\n');
+                    c.answers.pop_front();
+                }
+                c.changed.notify_all();
+                if (c.broken){
+                    out.clear();
+                    continue;
+                }
+            }
+            if (!sendAll(c.fd, out)){
+                //Nobody is listening, stop reading and drop the answers still to come
+                std::lock_guard<std::mutex> guard(c.lock);
+                c.broken = true;
+                ::shutdown(c.fd, SHUT_RD);
+                c.changed.notify_all();
+            }
+            out.clear();
+        }
+
+        std::lock_guard<std::mutex> guard(c.lock);
+        ::close(c.fd);
+        c.fd = -1;
+        c.finished = true;
+#endif
+    }
+
+    void SolverService::reap(){
+        std::lock_guard<std::mutex> guard(connectionsLock);
+        auto closed = std::stable_partition(connections.begin(), connections.end(),
+            [] (const std::shared_ptr<Connection>& connection){ return !connection->finished; });
+        for (auto it = closed; it != connections.end(); ++it){
+            (*it)->reader.join();
+            (*it)->writer.join();
+        }
+        connections.erase(closed, connections.end());
+    }
+
+} //End namespace sudoku
@@ -0,0 +1,239 @@
+#include "sudoku/simd.hpp"
+
+#include <cstring>
+
+//The AVX2 kernels are compiled with a target attribute, so the rest of the library still runs on any x86 CPU
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SUDOKU_AVX2_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace sudoku {
+
+    namespace {
+        using mask_type = Candidates::mask_type;
+
+        mask_type unitUsed(const uint8_t& unit, const UsedMasks& rowUsed, const UsedMasks& colUsed, const UsedMasks& boxUsed){
+            if (unit < number_of_element_values){
+                return rowUsed[unit];
+            }
+            if (unit < 2*number_of_element_values){
+                return colUsed[unit - number_of_element_values];
+            }
+            return boxUsed[unit - 2*number_of_element_values];
+        }
+
+        //Unit by unit checks shared by both scans, once and twice are the values seen in one and in several blank squares
+        void finishScan(SinglesScan& scan, const std::array<mask_type, unit_count>& once, const std::array<mask_type, unit_count>& twice,
+            const UsedMasks& rowUsed, const UsedMasks& colUsed, const UsedMasks& boxUsed){
+            for (uint8_t unit = 0; unit < unit_count; ++unit){
+                if ((once[unit] | unitUsed(unit, rowUsed, colUsed, boxUsed)) != Candidates::all_mask){
+                    scan.contradiction = true;
+                }
+                scan.hidden[unit] = once[unit] & ~twice[unit];
+            }
+        }
+
+#if defined(SUDOKU_AVX2_KERNELS)
+        //Each row of the board sits in the first 9 of 16 lanes, the board is copied into padded buffers
+        //so the last row can be loaded whole
+        constexpr int padded_size = (number_of_element_values - 1)*number_of_element_values + 16;
+
+        __attribute__((target("avx2")))
+        __m256i rowLanes(){
+            return _mm256_setr_epi16(-1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0);
+        }
+
+        //Blank lanes of row r, cells past the row are masked off
+        __attribute__((target("avx2")))
+        __m256i blankLanes(const uint8_t* cells, const int& r){
+            __m256i row = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cells + r*number_of_element_values)));
+            return _mm256_and_si256(_mm256_cmpeq_epi16(row, _mm256_set1_epi16(blank_element_value)), rowLanes());
+        }
+
+        //Moves every lane down by Lanes, filling the top with zeros
+        template <int Lanes>
+        __attribute__((target("avx2")))
+        __m256i shiftDown(const __m256i& x){
+            __m256i high = _mm256_permute2x128_si256(x, x, 0x81);
+            if constexpr (Lanes == 8){
+                return high;
+            }
+            else{
+                return _mm256_alignr_epi8(high, x, 2*Lanes);
+            }
+        }
+
+        //Folds the once and twice masks found Lanes lanes up into each lane
+        template <int Lanes>
+        __attribute__((target("avx2")))
+        void foldDown(__m256i& once, __m256i& twice, const __m256i& fromOnce, const __m256i& fromTwice){
+            __m256i otherOnce = shiftDown<Lanes>(fromOnce);
+            twice = _mm256_or_si256(_mm256_or_si256(twice, shiftDown<Lanes>(fromTwice)), _mm256_and_si256(once, otherOnce));
+            once = _mm256_or_si256(once, otherOnce);
+        }
+
+        __attribute__((target("avx2")))
+        void recomputePossiblesAvx2(Board& board, const UsedMasks& rowUsed, const UsedMasks& colUsed, const UsedMasks& boxUsed){
+            alignas(32) uint16_t out[padded_size];
+            alignas(16) uint8_t cells[padded_size] = {};
+            std::memcpy(cells, board.cells.data(), grid_size);
+
+            alignas(32) uint16_t cols[16] = {};
+            std::memcpy(cols, colUsed.data(), sizeof(colUsed));
+            __m256i colV = _mm256_load_si256(reinterpret_cast<const __m256i*>(cols));
+            __m256i all = _mm256_set1_epi16(Candidates::all_mask);
+
+            for (int r = 0; r < number_of_element_values; ++r){
+                const mask_type* box = boxUsed.data() + (r / box_size)*box_size;
+                __m256i boxV = _mm256_setr_epi16(box[0], box[0], box[0], box[1], box[1], box[1], box[2], box[2], box[2],
+                    0, 0, 0, 0, 0, 0, 0);
+                __m256i used = _mm256_or_si256(_mm256_or_si256(colV, boxV), _mm256_set1_epi16(rowUsed[r]));
+                __m256i possibles = _mm256_and_si256(_mm256_andnot_si256(used, all), blankLanes(cells, r));
+                //Lanes past the row spill into the next one, which is written over on the next pass
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + r*number_of_element_values), possibles);
+            }
+            std::memcpy(board.possibles.data(), out, sizeof(board.possibles));
+        }
+
+        __attribute__((target("avx2")))
+        SinglesScan scanSinglesAvx2(const Board& board, const UsedMasks& rowUsed, const UsedMasks& colUsed, const UsedMasks& boxUsed){
+            alignas(32) uint16_t masks[padded_size] = {};
+            alignas(16) uint8_t cells[padded_size] = {};
+            std::memcpy(masks, board.possibles.data(), sizeof(board.possibles));
+            std::memcpy(cells, board.cells.data(), grid_size);
+
+            SinglesScan scan;
+            std::array<mask_type, unit_count> once, twice;
+            alignas(32) uint16_t lanes[2][16];
+            __m256i zero = _mm256_setzero_si256();
+            __m256i empty = zero;
+            __m256i colOnce = zero, colTwice = zero;
+            __m256i bandOnce = zero, bandTwice = zero;
+
+            for (int r = 0; r < number_of_element_values; ++r){
+                __m256i blank = blankLanes(cells, r);
+                __m256i possibles = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks + r*number_of_element_values)), blank);
+                __m256i none = _mm256_cmpeq_epi16(possibles, zero);
+                empty = _mm256_or_si256(empty, _mm256_and_si256(blank, none));
+
+                //One possible left when clearing the lowest bit leaves nothing
+                __m256i lowestCleared = _mm256_and_si256(possibles, _mm256_add_epi16(possibles, _mm256_set1_epi16(-1)));
+                __m256i single = _mm256_andnot_si256(none, _mm256_cmpeq_epi16(lowestCleared, zero));
+                int bits = _mm256_movemask_epi8(_mm256_packs_epi16(single, zero));
+                scan.naked[r] = (bits & 0xff) | ((bits >> 8) & 0xff00);
+
+                //Columns line up lane for lane, so they fold straight down the rows
+                colTwice = _mm256_or_si256(colTwice, _mm256_and_si256(colOnce, possibles));
+                colOnce = _mm256_or_si256(colOnce, possibles);
+
+                //Rows fold across their own lanes, lane 0 ends up with the whole row
+                __m256i rowOnce = possibles, rowTwice = zero;
+                foldDown<1>(rowOnce, rowTwice, rowOnce, rowTwice);
+                foldDown<2>(rowOnce, rowTwice, rowOnce, rowTwice);
+                foldDown<4>(rowOnce, rowTwice, rowOnce, rowTwice);
+                foldDown<8>(rowOnce, rowTwice, rowOnce, rowTwice);
+                once[r] = _mm256_extract_epi16(rowOnce, 0);
+                twice[r] = _mm256_extract_epi16(rowTwice, 0);
+
+                //Boxes fold down the rows of a band, then across three lanes, landing in lanes 0, 3, and 6
+                bandTwice = _mm256_or_si256(bandTwice, _mm256_and_si256(bandOnce, possibles));
+                bandOnce = _mm256_or_si256(bandOnce, possibles);
+                if (r % box_size == box_size - 1){
+                    __m256i boxOnce = bandOnce, boxTwice = bandTwice;
+                    foldDown<1>(boxOnce, boxTwice, bandOnce, bandTwice);
+                    foldDown<2>(boxOnce, boxTwice, bandOnce, bandTwice);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[0]), boxOnce);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[1]), boxTwice);
+                    for (int b = 0; b < box_size; ++b){
+                        once[2*number_of_element_values + r - box_size + 1 + b] = lanes[0][b*box_size];
+                        twice[2*number_of_element_values + r - box_size + 1 + b] = lanes[1][b*box_size];
+                    }
+                    bandOnce = zero;
+                    bandTwice = zero;
+                }
+            }
+
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[0]), colOnce);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[1]), colTwice);
+            for (int c = 0; c < number_of_element_values; ++c){
+                once[number_of_element_values + c] = lanes[0][c];
+                twice[number_of_element_values + c] = lanes[1][c];
+            }
+
+            scan.contradiction = !_mm256_testz_si256(empty, empty);
+            finishScan(scan, once, twice, rowUsed, colUsed, boxUsed);
+            return scan;
+        }
+
+        bool cpuHasAvx2(){
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        }
+#else
+        bool cpuHasAvx2(){
+            return false;
+        }
+#endif
+    }
+
+    bool simdEnabled(){
+        static const bool enabled = cpuHasAvx2();
+        return enabled;
+    }
+
+    void recomputePossiblesScalar(Board& board, const UsedMasks& rowUsed, const UsedMasks& colUsed, const UsedMasks& boxUsed){
+        for (uint8_t i = 0; i < grid_size; ++i){
+            mask_type used = rowUsed[rowOf(i)] | colUsed[colOf(i)] | boxUsed[boxOf(i)];
+            board.possibles[i] = board[i].isBlank() ? Candidates::all_mask & ~used : 0;
+        }
+    }
+
+    SinglesScan scanSinglesScalar(const Board& board, const UsedMasks& rowUsed, const UsedMasks& colUsed, const UsedMasks& boxUsed){
+        SinglesScan scan;
+        for (uint8_t i = 0; i < grid_size; ++i){
+            mask_type possibles = board.possibles[i];
+            if (!board[i].isBlank()){
+                continue;
+            }
+            if (possibles == 0){
+                scan.contradiction = true;
+            }
+            else if ((possibles & (possibles - 1)) == 0){
+                scan.naked[rowOf(i)] |= 1u << colOf(i);
+            }
+        }
+
+        std::array<mask_type, unit_count> once{}, twice{};
+        for (uint8_t unit = 0; unit < unit_count; ++unit){
+            for (uint8_t index : peer_tables.units[unit]){
+                if (board[index].isBlank()){
+                    twice[unit] |= once[unit] & board.possibles[index];
+                    once[unit] |= board.possibles[index];
+                }
+            }
+        }
+        finishScan(scan, once, twice, rowUsed, colUsed, boxUsed);
+        return scan;
+    }
+
+    void recomputePossibles(Board& board, const UsedMasks& rowUsed, const UsedMasks& colUsed, const UsedMasks& boxUsed){
+#if defined(SUDOKU_AVX2_KERNELS)
+        if (simdEnabled()){
+            recomputePossiblesAvx2(board, rowUsed, colUsed, boxUsed);
+            return;
+        }
+#endif
+        recomputePossiblesScalar(board, rowUsed, colUsed, boxUsed);
+    }
+
+    SinglesScan scanSingles(const Board& board, const UsedMasks& rowUsed, const UsedMasks& colUsed, const UsedMasks& boxUsed){
+#if defined(SUDOKU_AVX2_KERNELS)
+        if (simdEnabled()){
+            return scanSinglesAvx2(board, rowUsed, colUsed, boxUsed);
+        }
+#endif
+        return scanSinglesScalar(board, rowUsed, colUsed, boxUsed);
+    }
+
+} //End namespace sudoku
@@ -1,142 +1,289 @@
 #include "sudoku/sudoku.hpp"
+#include "sudoku/dlx.hpp"
+#include "sudoku/parallel.hpp"
+#include "sudoku/simd.hpp"
 
-namespace sudoku {
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
 
-    Sudoku::Sudoku(std::ifstream &in, const SolveMethod& solver) : Sudoku(in){
-        this->solver = solver;
-    }
+namespace sudoku {
 
-    Sudoku::Sudoku(std::ifstream &in){
-        if (in.is_open()) {
-            while (in.peek() != EOF && grid.size() < grid_size){
-                char c = in.get();
-                //rn limited by using a char.
-                if (c > '0' && c <= '9'){
-                    grid.push_back(Square(c - '0', true));
-                }
-                else if (c == blank_input_element_value){
-                    grid.push_back(Square());
+    namespace {
+        //Adds the wall time until it goes out of scope to seconds, does nothing when stats are compiled out
+        class StatsTimer {
+            public:
+            explicit StatsTimer(double& seconds) : seconds(seconds) {
+                if constexpr (solve_stats_enabled){
+                    start = std::chrono::steady_clock::now();
                 }
             }
-            if (grid.size() != grid_size){
-                printf("Error: Sudoku file is not the correct size. Got %lu, expected %d.\n", grid.size(), grid_size);
-                return;
+            ~StatsTimer(){
+                if constexpr (solve_stats_enabled){
+                    seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                }
             }
 
-            //Check if the Sudoku is solvable and fill out possibles
-            //Possibles are not needed for brute force, but can speed it up
-            for (uint8_t i = 0; i < grid_size; ++i){
+            private:
+            double& seconds;
+            std::chrono::steady_clock::time_point start;
+        };
 
-                //If blank, fill out possibles
-                if(grid[i].isBlank()){
-                    for (uint8_t j = 1; j <= number_of_element_values; ++j){
-                        if (checkSquare(i, j)){
-                            grid[i].addPossible(j);
-                        }
-                    }
-                    //Check if blank square has possible values and check if square only has 1 possible value
-                    if (grid[i].checkPossibles()){
-                        if (grid[i].getPossibles().size() == 1){
-                            assignSquare(i, *grid[i].getPossibles().begin());
-                        }
-                    }
-                    else{
-                        printf("Error: Sudoku cell %u has no possible inputs\n", i);
-                        return;
-                    }
-                }
-                else if (!checkSquare(i)){
-                    printf("Error: Sudoku default cell %u is not valid\n", i);
-                    return;
-                }
-            }
-            //If it gets here no errors were found
-            logical = true;
+        const char* rule_names[RULE_COUNT] = {
+            "naked singles", "hidden singles", "naked pairs", "naked triples", "hidden pairs", "hidden triples", "intersections"
+        };
+    }
+
+    void SolveStats::addCounts(const SolveStats& other){
+        nodes += other.nodes;
+        backtracks += other.backtracks;
+        maxDepth = std::max(maxDepth, other.maxDepth);
+        for (int rule = 0; rule < RULE_COUNT; ++rule){
+            deductions[rule] += other.deductions[rule];
         }
+        eliminations += other.eliminations;
     }
 
-    bool Sudoku::eachInRow(const uint8_t& index, const std::function<bool(uint8_t, std::vector<Square>&)>& func){
-        uint8_t row = index / number_of_element_values;
-        uint8_t col = index % number_of_element_values;
+    void SolveStats::print() const{
+        if constexpr (!solve_stats_enabled){
+            printf("Solve stats were compiled out (SUDOKU_SOLVE_STATS=0)\n");
+            return;
+        }
+        printf("Nodes: %" PRIu64 ", backtracks: %" PRIu64 ", max depth: %u\n", nodes, backtracks, maxDepth);
+        printf("Eliminations: %" PRIu64 "\n", eliminations);
+        printf("Deductions:");
+        for (int rule = 0; rule < RULE_COUNT; ++rule){
+            printf("%s %" PRIu64 " %s", rule == 0 ? "" : ",", deductions[rule], rule_names[rule]);
+        }
+        printf("\nTime: parse %.3f ms, propagate %.3f ms, search %.3f ms\n",
+            parseSeconds*1000, propagateSeconds*1000, searchSeconds*1000);
+    }
 
-        for (uint8_t i = 0; i < number_of_element_values; ++i){
-            //Skip if current square and check function
-            if (i != col && !func(row*number_of_element_values + i, grid)){
-                return false;
+    template <int BoxSize>
+    template <typename Func>
+    bool BasicSudoku<BoxSize>::timeSearch(Func&& search){
+        if constexpr (!solve_stats_enabled){
+            return search();
+        }
+        else{
+            double propagated = stats.propagateSeconds;
+            double seconds = 0;
+            bool result;
+            {
+                StatsTimer timer(seconds);
+                result = search();
             }
+            stats.searchSeconds += seconds - (stats.propagateSeconds - propagated);
+            return result;
         }
-        return true;
     }
 
-    bool Sudoku::eachInCol(const uint8_t& index, const std::function<bool(uint8_t, std::vector<Square>&)>& func){
-        uint8_t row = index / number_of_element_values;
-        uint8_t col = index % number_of_element_values;
+    template <int BoxSize>
+    BasicSudoku<BoxSize>::BasicSudoku(std::istream &in, const SolveMethod& solver) : BasicSudoku(in){
+        this->solver = solver;
+    }
 
-        for (uint8_t i = 0; i < number_of_element_values; ++i){
-            //Skip if current square and check function
-            if (i != row && !func(i*number_of_element_values + col, grid)){
-                return false;
-            }
+    //Adds the square c stands for after the squares already read, returns false if c is not a grid symbol
+    //Compact also takes '.' and '0' as blanks, '0' is never a value at any size
+    template <int BoxSize, bool Compact>
+    static bool readSymbol(const char& c, BasicBoard<BoxSize>& grid, uint16_t& squares){
+        //Values past 9 use letters, so a char is enough up to 25x25
+        if (uint8_t val = GridTraits<BoxSize>::valueOf(c)){
+            grid.cells[squares++] = BasicBoard<BoxSize>::given_bit | val;
+            return true;
         }
-        return true;
+        else if (c == blank_input_element_value || (Compact && (c == compact_blank_values[0] || c == compact_blank_values[1]))){
+            grid.cells[squares++] = GridTraits<BoxSize>::blank_element_value;
+            return true;
+        }
+        return false;
+    }
+
+    template <int BoxSize>
+    BasicSudoku<BoxSize>::BasicSudoku(std::istream &in){
+        //Not opened ifstreams read as nothing, the grid stays empty and not logical
+        if (!in){
+            return;
+        }
+        StatsTimer timer(stats.parseSeconds);
+        //Straight from the stream buffer, stopping right after the last square so the rest can still be read
+        std::streambuf* buffer = in.rdbuf();
+        for (int c = 0; squares < grid_size && (c = buffer->sbumpc()) != std::char_traits<char>::eof(); ){
+            readSymbol<BoxSize, false>(char(c), grid, squares);
+        }
+        initialize();
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::load(std::string_view puzzle){
+        StatsTimer timer(stats.parseSeconds);
+        grid = Board();
+        squares = 0;
+        for (std::size_t i = 0; i < puzzle.size() && squares < grid_size; ++i){
+            readSymbol<BoxSize, true>(puzzle[i], grid, squares);
+        }
+        initialize();
+        return logical;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::load(const Board& board){
+        StatsTimer timer(stats.parseSeconds);
+        grid = Board();
+        grid.cells = board.cells;
+        squares = grid_size;
+        initialize();
+        return logical;
     }
 
-    bool Sudoku::eachInBox(const uint8_t& index, const std::function<bool(uint8_t, std::vector<Square>&)>& func){
-        uint8_t row = index / number_of_element_values;
-        uint8_t col = index % number_of_element_values;
-        uint8_t box = (row / box_size)*box_size + (col / box_size);
-
-        uint8_t boxIndex = ((row % box_size)*box_size + (col %box_size)); 
-        for (uint8_t i = 0; i < number_of_element_values; ++i){
-            //Location in current box
-            uint8_t boxRow = i / box_size;
-            uint8_t boxCol = i % box_size;
-            //Location in grid
-            uint8_t realRow = boxRow + (box/box_size)*box_size;
-            uint8_t realCol = boxCol + (box%box_size)*box_size;
-            //Skip if current square and check function
-            if (i != boxIndex && !func(realRow*number_of_element_values + realCol, grid)){
+    template <int BoxSize>
+    void BasicSudoku<BoxSize>::initialize(){
+        logical = false;
+        steps = 0;
+        stats = SolveStats();
+        trail.clear();
+        moves.clear();
+        deadSquares = 0;
+        paused = false;
+        hasWitness = false;
+        rowUsed.fill(0);
+        colUsed.fill(0);
+        boxUsed.fill(0);
+        if (squares != grid_size){
+            printf("Error: Sudoku file is not the correct size. Got %u, expected %d.\n", squares, grid_size);
+            return;
+        }
+
+        //assignSquare only removes possibles from related squares when not backtracking
+        SolveMethod method = solver;
+        solver = NONE;
+        logical = fillPossibles();
+        solver = method;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::fillPossibles(){
+        //Record the givens so possibles can be read from the row, column, and box masks
+        for (index_type i = 0; i < grid_size; ++i){
+            if (!grid[i].isBlank()){
+                markUsed(i, grid[i].getElement());
+            }
+        }
+
+        //9x9 boards fill every blank square in one pass of the vector kernel
+        if constexpr (box_size == 3){
+            recomputePossibles(grid, rowUsed, colUsed, boxUsed);
+        }
+
+        //Check if the Sudoku is solvable and fill out possibles
+        //Possibles are not needed for brute force, but can speed it up
+        for (index_type i = 0; i < grid_size; ++i){
+
+            //If blank, fill out possibles
+            if(grid[i].isBlank()){
+                if constexpr (box_size != 3){
+                    grid[i].setPossibles(Candidates::fromMask(~usedMask(i)));
+                }
+                //Check if blank square has possible values and check if square only has 1 possible value
+                if (grid[i].checkPossibles()){
+                    if (grid[i].getPossibles().size() == 1){
+                        assignSquare(i, *grid[i].getPossibles().begin());
+                    }
+                }
+                else{
+                    printf("Error: Sudoku cell %u has no possible inputs\n", i);
+                    return false;
+                }
+            }
+            else if (!checkSquare(i)){
+                printf("Error: Sudoku default cell %u is not valid\n", i);
                 return false;
             }
         }
+        //If it gets here no errors were found
         return true;
     }
 
-    bool Sudoku::checkSquare(const uint8_t& index){
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::eachInRow(const index_type& index, const std::function<bool(index_type, Board&)>& func){
+        return visitRow(index, func);
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::eachInCol(const index_type& index, const std::function<bool(index_type, Board&)>& func){
+        return visitCol(index, func);
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::eachInBox(const index_type& index, const std::function<bool(index_type, Board&)>& func){
+        return visitBox(index, func);
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::checkSquare(const index_type& index){
         if (index >= grid_size){
             printf("Error: Index %u is out of bounds\n", index);
             return false;
         }
         //compare index to row, col, and box
         //Returns true if the compared squares are logical
-        auto func = [index] (uint8_t targ_index, std::vector<Square> &grid){
+        auto func = [index] (index_type targ_index, Board &grid){
             return grid[index].getElement() != grid[targ_index].getElement();
         };
 
         //Check if the square is valid
-        return eachInRow(index, func) && eachInCol(index, func) && eachInBox(index, func);
+        return visitPeers(index, func);
     }
 
-    bool Sudoku::checkSquare(const uint8_t& index, const uint8_t& potential){
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::checkSquare(const index_type& index, const uint8_t& potential){
         if (index >= grid_size){
             printf("Error: Index %u is out of bounds\n", index);
             return false;
         }
         
-        //Set test value, only success if potential is valid and not blank
-        if (!grid[index].setElement(potential)){
+        //Only success if potential is valid and not blank
+        if (potential == 0 || potential > number_of_element_values){
             return false;
         }
-        
-        bool valid = checkSquare(index);
 
-        //reset the square to blank
-        grid[index].setToOriginalValue();
+        //Blank squares are not part of the masks, so a single lookup is enough
+        if (grid[index].isBlank()){
+            return !(usedMask(index) & Candidates::bit(potential));
+        }
+
+        //Filled squares are part of their own masks, compare against the related squares instead
+        return visitPeers(index, [potential] (index_type targ_index, Board &grid){
+            return grid[targ_index].getElement() != potential;
+        });
+    }
 
-        return valid;
+    template <int BoxSize>
+    void BasicSudoku<BoxSize>::markUsed(const index_type& index, const uint8_t& val){
+        mask_type bit = Candidates::bit(val);
+        rowUsed[traits::rowOf(index)] |= bit;
+        colUsed[traits::colOf(index)] |= bit;
+        boxUsed[traits::boxOf(index)] |= bit;
+    }
+
+    template <int BoxSize>
+    void BasicSudoku<BoxSize>::clearUsed(const index_type& index, const uint8_t& val){
+        mask_type bit = ~Candidates::bit(val);
+        rowUsed[traits::rowOf(index)] &= bit;
+        colUsed[traits::colOf(index)] &= bit;
+        boxUsed[traits::boxOf(index)] &= bit;
+    }
+
+    template <int BoxSize>
+    void BasicSudoku<BoxSize>::unassignSquare(const index_type& index){
+        if (!grid[index].isBlank()){
+            clearUsed(index, grid[index].getElement());
+        }
+        grid[index].setToOriginalValue();
     }
 
-    bool Sudoku::assignSquare(const uint8_t& index, const uint8_t& val){
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::assignSquare(const index_type& index, const uint8_t& val){
         if (index >= grid_size){
             printf("Error: Index %u is out of bounds\n", index);
             return false;
@@ -150,96 +297,996 @@ namespace sudoku {
             printf("Error: Invalid input %u at index %u\n", val, index);
             return false;
         }
+        markUsed(index, val);
         //We want to to keep possibles when backtracking
         if (solver == BACKTRACK){
             return true;
         }
 
         //Since we are assigning a value, no squares associated can have val as a possible
-        auto func = [val] (uint8_t targ_index, std::vector<Square> &grid){
+        auto func = [this, val] (index_type targ_index, Board &grid){
+            if (grid[targ_index].isBlank()){
+                countEliminations(grid.possibles[targ_index] & Candidates::bit(val));
+            }
             grid[targ_index].removePossible(val); return true;
         };
 
         //This will always return true, but this allows us to use the return values
-        return eachInRow(index, func) && eachInCol(index, func) && eachInBox(index, func);
+        return visitPeers(index, func);
         
     }
 
-    void Sudoku::printGrid() const{
+    template <int BoxSize>
+    auto BasicSudoku<BoxSize>::getGrid() const -> std::vector<Square> {
+        std::vector<Square> copy;
+        copy.reserve(squares);
+        for (index_type i = 0; i < squares; ++i){
+            copy.push_back(grid[i]);
+        }
+        return copy;
+    }
+
+    template <int BoxSize>
+    void BasicSudoku<BoxSize>::printGrid() const{
         printf("\nInput:");
-        printGridStdout(grid, true);
+        printGridStdout(true);
         printf("\nOutput:");
-        printGridStdout(grid);
+        printGridStdout();
         printf("\nSteps: %u\n", steps);
     }
 
-    //Prints grid to stdout
-    void Sudoku::printGridStdout(const std::vector<Square>& grid, const bool& printGivens) const{
-        printf("\n~~~~~~~~~~~~~~~~~~~~~~~~~");
+    template <int BoxSize>
+    void BasicSudoku<BoxSize>::appendLine(std::string& out) const{
+        for (index_type i = 0; i < squares; ++i){
+            out.push_back(grid[i].isBlank() ? blank_input_element_value : traits::symbolOf(grid[i].getElement()));
+        }
+    }
+
+    //Prints grid to stdout, built up in one string so it goes out in a single write
+    template <int BoxSize>
+    void BasicSudoku<BoxSize>::printGridStdout(const bool& printGivens) const{
+        //Two characters per square and per box border, 25 wide for 9x9
+        const std::string rule(box_size*(2*box_size + 2) + 1, '~');
+        std::string out;
+        out.reserve((number_of_element_values + box_size + 1)*(rule.size() + 1));
+        out.append("\n").append(rule);
         uint8_t rowSplit = -1; //buffer the first increment
-        for (uint8_t i = 0; i < grid.size(); ++i){
+        for (index_type i = 0; i < squares; ++i){
             if (i % box_size == 0 && i != 0){
-                printf("| ");
+                out.append("| ");
             }
             if (i % number_of_element_values == 0){
                 ++rowSplit;
                 if (rowSplit == box_size){
-                    printf("\n~~~~~~~~~~~~~~~~~~~~~~~~~");
+                    out.append("\n").append(rule);
                     rowSplit = 0;
                 }
-                printf("\n| ");
+                out.append("\n| ");
             }
             
             if (grid[i].isBlank() || (printGivens && !grid[i].isGiven())){
-                printf("%c ", blank_input_element_value);
+                out.push_back(blank_input_element_value);
             }
             else{
-                printf("%u ", grid[i].getElement());
+                out.push_back(traits::symbolOf(grid[i].getElement()));
             }
+            out.push_back(' ');
         }
-        printf("|\n~~~~~~~~~~~~~~~~~~~~~~~~~\n");
+        out.append("|\n").append(rule).append("\n");
+        fwrite(out.data(), 1, out.size(), stdout);
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::solveBacktrack(){
+        startBacktrack();
+        return runBacktrack(0) == SOLVED;
     }
 
-    bool Sudoku::solveBacktrack(){
+    template <int BoxSize>
+    void BasicSudoku<BoxSize>::startBacktrack(){
         solver = BACKTRACK;
-        ++steps;
-        //Find the first blank square, if end of grid is reached, soduko is solved
-        uint8_t index;
-        auto curBlank = find_if(grid.begin(), grid.end(), [] (Square s){
-            return s.isBlank();
+        blankCount = 0;
+        for (index_type i = 0; i < grid_size; ++i){
+            if (grid.cells[i] == blank_element_value){
+                blanks[blankCount++] = i;
+            }
+        }
+        searchDepth = 0;
+        entering = true;
+    }
+
+    //Same search as the recursive version always did, first blank square first and values in order,
+    //so the nodes and backtracks counted come out the same
+    template <int BoxSize>
+    SolveStatus BasicSudoku<BoxSize>::runBacktrack(const uint64_t& budget){
+        uint64_t visited = 0;
+        while (true){
+            if (entering){
+                if (budget != 0 && visited == budget){
+                    paused = true;
+                    return PAUSED;
+                }
+                if (limits != nullptr && stopSearch()){
+                    //Not kept to resume, put the grid back to the givens
+                    while (searchDepth > 0){
+                        unassignSquare(frames[--searchDepth].index);
+                    }
+                    entering = false;
+                    paused = false;
+                    return stopped;
+                }
+                ++visited;
+                ++steps;
+                countNode(searchDepth);
+                //Every blank is filled, soduko is solved
+                if (searchDepth == blankCount){
+                    entering = false;
+                    paused = false;
+                    return SOLVED;
+                }
+                //Values used by a related square can't work, and nothing changes them until this square is left
+                index_type index = blanks[searchDepth];
+                frames[searchDepth] = {index, mask_type(grid.possibles[index] & ~usedMask(index))};
+                entering = false;
+            }
+
+            //Try the next value, going down a level on the first one that fits
+            SearchFrame& frame = frames[searchDepth];
+            if (frame.remaining != 0){
+                uint8_t val = lowestBit(frame.remaining) + 1;
+                frame.remaining &= frame.remaining - 1;
+                grid[frame.index].setElement(val);
+                markUsed(frame.index, val);
+                ++searchDepth;
+                entering = true;
+                continue;
+            }
+
+            //Out of values, revert back to the square above and carry on with its next value
+            if (searchDepth == 0){
+                paused = false;
+                return NO_SOLUTION;
+            }
+            --searchDepth;
+            unassignSquare(frames[searchDepth].index);
+            countBacktrack();
+        }
+    }
+
+    template <int BoxSize>
+    void BasicSudoku<BoxSize>::dropPaused(){
+        if (!paused){
+            return;
+        }
+        while (searchDepth > 0){
+            unassignSquare(frames[--searchDepth].index);
+        }
+        entering = false;
+        paused = false;
+    }
+
+    template <int BoxSize>
+    SolveStatus BasicSudoku<BoxSize>::solveFor(const uint64_t& nodeBudget){
+        if (!logical){
+            return NO_SOLUTION;
+        }
+        dropPaused();
+        moves.clear();
+        trail.clear();
+        //A fresh search is one paused before its root
+        startBacktrack();
+        paused = true;
+        return resume(nodeBudget);
+    }
+
+    template <int BoxSize>
+    SolveStatus BasicSudoku<BoxSize>::resume(const uint64_t& nodeBudget){
+        if (!paused){
+            printf("Error: No paused search to resume\n");
+            return NO_SOLUTION;
+        }
+        SolveStatus status = NO_SOLUTION;
+        timeSearch([this, &nodeBudget, &status] {
+            status = runBacktrack(nodeBudget);
+            return status == SOLVED;
         });
+        return status;
+    }
 
-        if (curBlank == grid.end()){
-            return true;
+    template <int BoxSize>
+    auto BasicSudoku<BoxSize>::unitUsed(const uint8_t& unit) const -> mask_type {
+        if (unit < number_of_element_values){
+            return rowUsed[unit];
+        }
+        if (unit < 2*number_of_element_values){
+            return colUsed[unit - number_of_element_values];
+        }
+        return boxUsed[unit - 2*number_of_element_values];
+    }
+
+    template <int BoxSize>
+    auto BasicSudoku<BoxSize>::unitPositions(const uint8_t& unit, const uint8_t& val) const -> mask_type {
+        mask_type positions = 0;
+        for (uint8_t p = 0; p < number_of_element_values; ++p){
+            auto square = grid[peer_tables.units[unit][p]];
+            if (square.isBlank() && square.getPossibles().contains(val)){
+                positions |= 1u << p;
+            }
+        }
+        return positions;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::eliminate(const index_type& index, const mask_type& mask){
+        mask_type possibles = grid[index].getPossibles().mask();
+        if (!grid[index].isBlank() || !(possibles & mask)){
+            return false;
+        }
+        grid[index].setPossibles(Candidates::fromMask(possibles & ~mask));
+        countEliminations(possibles & mask);
+        return true;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::hasContradiction() const {
+        for (index_type i = 0; i < grid_size; ++i){
+            if (!grid[i].checkPossibles()){
+                return true;
+            }
+        }
+        //Every value missing from a unit needs somewhere to go
+        for (uint8_t unit = 0; unit < unit_count; ++unit){
+            mask_type possible = 0;
+            for (index_type index : peer_tables.units[unit]){
+                if (grid[index].isBlank()){
+                    possible |= grid[index].getPossibles().mask();
+                }
+            }
+            if ((possible | unitUsed(unit)) != Candidates::all_mask){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::isSolved() const {
+        return std::find(grid.cells.begin(), grid.cells.end(), blank_element_value) == grid.cells.end();
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::applyNakedSingles(){
+        bool changed = false;
+        for (index_type i = 0; i < grid_size; ++i){
+            if (grid[i].isBlank() && grid[i].getPossibles().size() == 1){
+                assignSquare(i, *grid[i].getPossibles().begin());
+                ++steps;
+                countDeduction(NAKED_SINGLE);
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::applyHiddenSingles(){
+        bool changed = false;
+        for (uint8_t unit = 0; unit < unit_count; ++unit){
+            for (uint8_t val : Candidates::fromMask(~unitUsed(unit))){
+                mask_type positions = unitPositions(unit, val);
+                //No positions is a contradiction, left for hasContradiction to report
+                if (positions != 0 && (positions & (positions - 1)) == 0){
+                    assignSquare(peer_tables.units[unit][lowestBit(positions)], val);
+                    ++steps;
+                    countDeduction(HIDDEN_SINGLE);
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::applyNakedSubsets(const uint8_t& size){
+        bool changed = false;
+        for (uint8_t unit = 0; unit < unit_count; ++unit){
+            const auto& squares = peer_tables.units[unit];
+            //Blank squares small enough to be part of a subset
+            mask_type open = 0;
+            for (uint8_t p = 0; p < number_of_element_values; ++p){
+                auto square = grid[squares[p]];
+                if (square.isBlank() && square.getPossibles().size() <= size){
+                    open |= 1u << p;
+                }
+            }
+            //Walk every combination of size squares out of the open ones
+            for (mask_type subset = open; subset != 0; subset = (subset - 1) & open){
+                if (bitCount(subset) != size){
+                    continue;
+                }
+                mask_type vals = 0;
+                for (mask_type bits = subset; bits != 0; bits &= bits - 1){
+                    vals |= grid[squares[lowestBit(bits)]].getPossibles().mask();
+                }
+                if (bitCount(vals) != size){
+                    continue;
+                }
+                //size squares share size values, so no other square in the unit can take them
+                bool eliminated = false;
+                for (uint8_t p = 0; p < number_of_element_values; ++p){
+                    if (!(subset & (1u << p))){
+                        eliminated |= eliminate(squares[p], vals);
+                    }
+                }
+                if (eliminated){
+                    ++steps;
+                    countDeduction(size == 2 ? NAKED_PAIR : NAKED_TRIPLE);
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::applyHiddenSubsets(const uint8_t& size){
+        bool changed = false;
+        for (uint8_t unit = 0; unit < unit_count; ++unit){
+            const auto& squares = peer_tables.units[unit];
+            std::array<mask_type, number_of_element_values> positions{};
+            mask_type open = 0;
+            for (uint8_t val : Candidates::fromMask(~unitUsed(unit))){
+                positions[val - 1] = unitPositions(unit, val);
+                if (bitCount(positions[val - 1]) <= size){
+                    open |= Candidates::bit(val);
+                }
+            }
+            //Walk every combination of size values out of the open ones
+            for (mask_type vals = open; vals != 0; vals = (vals - 1) & open){
+                if (bitCount(vals) != size){
+                    continue;
+                }
+                mask_type where = 0;
+                for (uint8_t val : Candidates::fromMask(vals)){
+                    where |= positions[val - 1];
+                }
+                if (bitCount(where) != size){
+                    continue;
+                }
+                //size values only fit in size squares, so those squares can't take anything else
+                bool eliminated = false;
+                for (mask_type bits = where; bits != 0; bits &= bits - 1){
+                    eliminated |= eliminate(squares[lowestBit(bits)], ~vals);
+                }
+                if (eliminated){
+                    ++steps;
+                    countDeduction(size == 2 ? HIDDEN_PAIR : HIDDEN_TRIPLE);
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::applyIntersections(){
+        bool changed = false;
+        //Rows and columns are (box_size) segments long in each box they cross
+        constexpr mask_type segment = (1u << box_size) - 1;
+
+        for (uint8_t unit = 0; unit < unit_count; ++unit){
+            const auto& squares = peer_tables.units[unit];
+            bool isBox = unit >= 2*number_of_element_values;
+            for (uint8_t val : Candidates::fromMask(~unitUsed(unit))){
+                mask_type positions = unitPositions(unit, val);
+                if (positions == 0){
+                    continue;
+                }
+                for (uint8_t k = 0; k < box_size; ++k){
+                    uint8_t target;
+                    if (isBox){
+                        //Pointing: all positions in one row of the box clear the rest of that row
+                        mask_type rowBits = segment << (k*box_size);
+                        mask_type colBits = 0;
+                        for (uint8_t r = 0; r < box_size; ++r){
+                            colBits |= 1u << (r*box_size + k);
+                        }
+                        if ((positions & ~rowBits) == 0){
+                            target = traits::rowOf(squares[k*box_size]);
+                        }
+                        else if ((positions & ~colBits) == 0){
+                            target = number_of_element_values + traits::colOf(squares[k]);
+                        }
+                        else{
+                            continue;
+                        }
+                    }
+                    else{
+                        //Box-line: all positions in one box of the row or column clear the rest of that box
+                        if ((positions & ~(segment << (k*box_size))) != 0){
+                            continue;
+                        }
+                        target = 2*number_of_element_values + traits::boxOf(squares[k*box_size]);
+                    }
+                    bool eliminated = false;
+                    for (index_type index : peer_tables.units[target]){
+                        if (std::find(squares.begin(), squares.end(), index) == squares.end()){
+                            eliminated |= eliminate(index, Candidates::bit(val));
+                        }
+                    }
+                    if (eliminated){
+                        ++steps;
+                        countDeduction(INTERSECTION);
+                        changed = true;
+                    }
+                    break;
+                }
+            }
+        }
+        return changed;
+    }
+
+    //Applies the rules until none of them make progress, no guessing is done
+    //steps counts the deductions made
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::solveRules(){
+        solver = RULES;
+        StatsTimer timer(stats.propagateSeconds);
+        Difficulty hardest = EASY;
+        return applyRules(hardest);
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::applyRules(Difficulty& hardest){
+        while (!hasContradiction()){
+            //Cheapest rules first, start over whenever something changed
+            if (applyNakedSingles() || applyHiddenSingles()){
+                continue;
+            }
+            if (applyIntersections()){
+                hardest = std::max(hardest, MEDIUM);
+                continue;
+            }
+            bool subsets = false;
+            for (uint8_t size = 2; size <= 3 && !subsets; ++size){
+                subsets = applyNakedSubsets(size) || applyHiddenSubsets(size);
+            }
+            if (!subsets){
+                return isSolved();
+            }
+            hardest = std::max(hardest, HARD);
+        }
+        return false;
+    }
+
+    template <int BoxSize>
+    Difficulty BasicSudoku<BoxSize>::grade() const{
+        if (!logical){
+            return EXPERT;
+        }
+        BasicSudoku copy = *this;
+        copy.dropPaused();
+        copy.solver = RULES;
+        Difficulty hardest = EASY;
+        return copy.applyRules(hardest) ? hardest : EXPERT;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::placeTrailed(const index_type& index, const uint8_t& val){
+        trail.push_back({index, grid.cells[index], grid.possibles[index]});
+        grid[index].setElement(val);
+        markUsed(index, val);
+
+        mask_type bit = Candidates::bit(val);
+        return visitPeers(index, [this, bit] (index_type targ_index, Board &grid){
+            auto square = grid[targ_index];
+            mask_type possibles = grid.possibles[targ_index];
+            if (!square.isBlank() || !(possibles & bit)){
+                return true;
+            }
+            trail.push_back({targ_index, grid.cells[targ_index], possibles});
+            square.setPossibles(Candidates::fromMask(possibles & ~bit));
+            countEliminations(bit);
+            return possibles != bit;
+        });
+    }
+
+    template <int BoxSize>
+    void BasicSudoku<BoxSize>::undoTrail(const std::size_t& mark){
+        while (trail.size() > mark){
+            const TrailEntry& entry = trail.back();
+            if (!grid[entry.index].isBlank() && entry.cell == blank_element_value){
+                clearUsed(entry.index, grid[entry.index].getElement());
+            }
+            grid.cells[entry.index] = entry.cell;
+            grid.possibles[entry.index] = entry.possibles;
+            trail.pop_back();
+        }
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::place(const index_type& index, const uint8_t& val){
+        dropPaused();
+        if (!logical || index >= grid_size || !grid[index].isBlank() || !grid[index].getPossibles().contains(val)){
+            return false;
+        }
+        moves.push_back({trail.size(), deadSquares});
+        trail.push_back({index, grid.cells[index], grid.possibles[index]});
+        grid[index].setElement(val);
+        markUsed(index, val);
+
+        //Unlike placeTrailed every peer is updated, the move stays on the board even if it leads nowhere
+        mask_type bit = Candidates::bit(val);
+        for (index_type target : peer_tables.all[index]){
+            mask_type possibles = grid.possibles[target];
+            if (grid[target].isBlank() && (possibles & bit)){
+                trail.push_back({target, grid.cells[target], possibles});
+                grid.possibles[target] = possibles & ~bit;
+                deadSquares += possibles == bit;
+            }
+        }
+        return true;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::undo(){
+        if (moves.empty()){
+            return false;
+        }
+        undoTrail(moves.back().mark);
+        deadSquares = moves.back().dead;
+        moves.pop_back();
+        return true;
+    }
+
+    template <int BoxSize>
+    auto BasicSudoku<BoxSize>::candidates(const index_type& index) const -> Candidates {
+        if (index >= grid_size || !grid[index].isBlank()){
+            return Candidates();
+        }
+        return grid[index].getPossibles();
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::isSolvable(){
+        dropPaused();
+        if (!logical || deadSquares != 0){
+            return false;
+        }
+        //Still on the way to the last solution, nothing to search
+        if (hasWitness){
+            bool agrees = true;
+            for (index_type i = 0; i < grid_size && agrees; ++i){
+                agrees = grid[i].isBlank() || grid[i].getElement() == witness[i].getElement();
+            }
+            if (agrees){
+                return true;
+            }
+        }
+
+        std::size_t mark = trail.size();
+        bool solvable = timeSearch([this] {
+            return propagateSingles() && searchHybrid();
+        });
+        if (solvable){
+            witness = grid;
+            hasWitness = true;
+        }
+        undoTrail(mark);
+        return solvable;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::propagateSingles(){
+        StatsTimer timer(stats.propagateSeconds);
+        if constexpr (box_size == 3){
+            return propagateScanned();
         }
         else{
-            index = curBlank - grid.begin();
+            return propagateUnits();
+        }
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::propagateUnits(){
+        bool changed = true;
+        while (changed){
+            changed = false;
+            for (index_type i = 0; i < grid_size; ++i){
+                if (!grid[i].isBlank()){
+                    continue;
+                }
+                Candidates possibles = grid[i].getPossibles();
+                if (possibles.empty()){
+                    return false;
+                }
+                if (possibles.size() == 1){
+                    if (!placeTrailed(i, *possibles.begin())){
+                        return false;
+                    }
+                    countDeduction(NAKED_SINGLE);
+                    changed = true;
+                }
+            }
+            for (uint8_t unit = 0; unit < unit_count; ++unit){
+                //Values seen once and more than once among the blank squares of the unit
+                mask_type once = 0, twice = 0;
+                for (index_type index : peer_tables.units[unit]){
+                    if (grid[index].isBlank()){
+                        mask_type possibles = grid[index].getPossibles().mask();
+                        twice |= once & possibles;
+                        once |= possibles;
+                    }
+                }
+                if ((once | unitUsed(unit)) != Candidates::all_mask){
+                    return false;
+                }
+                mask_type hidden = once & ~twice;
+                for (index_type index : peer_tables.units[unit]){
+                    mask_type single = grid[index].getPossibles().mask() & hidden;
+                    if (single == 0 || !grid[index].isBlank()){
+                        continue;
+                    }
+                    //Two hidden singles in one square can't both be placed
+                    if (bitCount(single) > 1){
+                        return false;
+                    }
+                    if (!placeTrailed(index, lowestBit(single) + 1)){
+                        return false;
+                    }
+                    countDeduction(HIDDEN_SINGLE);
+                    hidden &= ~single;
+                    changed = true;
+                }
+            }
         }
+        return true;
+    }
 
-        //Try each possible value
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::propagateScanned(){
+        //The kernels only cover 9x9, other sizes never get here
+        if constexpr (box_size != 3){
+            return propagateUnits();
+        }
+        else{
+            while (true){
+                //Every single on the board found at once, then placed while checking nothing changed under it
+                SinglesScan scan = scanSingles(grid, rowUsed, colUsed, boxUsed);
+                if (scan.contradiction){
+                    return false;
+                }
+                bool changed = false;
+                for (index_type r = 0; r < number_of_element_values; ++r){
+                    for (mask_type cols = scan.naked[r]; cols != 0; cols &= cols - 1){
+                        index_type index = r*number_of_element_values + lowestBit(cols);
+                        mask_type possibles = grid.possibles[index];
+                        if (!grid[index].isBlank()){
+                            continue;
+                        }
+                        //Possibles only shrink, an earlier placement can only have emptied it
+                        if (possibles == 0 || !placeTrailed(index, lowestBit(possibles) + 1)){
+                            return false;
+                        }
+                        countDeduction(NAKED_SINGLE);
+                        changed = true;
+                    }
+                }
+                for (uint8_t unit = 0; unit < unit_count; ++unit){
+                    for (mask_type hidden = scan.hidden[unit] & ~unitUsed(unit); hidden != 0; hidden &= hidden - 1){
+                        mask_type bit = hidden & -hidden;
+                        //The scan saw one blank square for this value, it is either still there or gone
+                        int found = -1;
+                        for (index_type index : peer_tables.units[unit]){
+                            if (grid[index].isBlank() && (grid.possibles[index] & bit)){
+                                found = index;
+                                break;
+                            }
+                        }
+                        if (found == -1 || !placeTrailed(found, lowestBit(bit) + 1)){
+                            return false;
+                        }
+                        countDeduction(HIDDEN_SINGLE);
+                        changed = true;
+                    }
+                }
+                if (!changed){
+                    return true;
+                }
+            }
+        }
+    }
+
+    template <int BoxSize>
+    int BasicSudoku<BoxSize>::pickBranchSquare() const {
+        int index = -1;
+        std::size_t fewest = number_of_element_values + 1;
+        for (index_type i = 0; i < grid_size && fewest > 2; ++i){
+            if (grid[i].isBlank() && grid[i].getPossibles().size() < fewest){
+                index = i;
+                fewest = grid[i].getPossibles().size();
+            }
+        }
+        return index;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::stopSearch(){
+        //Checked before the node is counted, so a node limit stops after exactly maxNodes
+        if (limits != nullptr && stopped == SOLVED){
+            stopped = limits->check(steps - limitStart + 1);
+        }
+        return stopped != SOLVED || (cancelled != nullptr && cancelled->load(std::memory_order_relaxed));
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::searchHybrid(const uint16_t& depth){
+        //Another thread already found a solution, or a limit was hit
+        if (stopSearch()){
+            return false;
+        }
+        ++steps;
+        countNode(depth);
+        //Branch on the blank square with the fewest possibles
+        int index = pickBranchSquare();
+        if (index == -1){
+            return true;
+        }
+
+        std::size_t mark = trail.size();
+        for (uint8_t val : grid[index].getPossibles()){
+            //Values propagation turns down never become nodes, only an undone child node is a backtrack
+            bool open = placeTrailed(index, val) && propagateSingles();
+            if (open && searchHybrid(depth + 1)){
+                return true;
+            }
+            undoTrail(mark);
+            if (stopped != SOLVED){
+                return false;
+            }
+            if (open){
+                countBacktrack();
+            }
+        }
+        return false;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::solveHybrid(){
+        solver = HYBRID;
+        trail.clear();
+        //Each placement changes at most itself and its peers, so the trail never reallocates mid search
+        trail.reserve(grid_size*(peer_count + 1));
+        if (!propagateSingles()){
+            undoTrail(0);
+            return false;
+        }
+        bool solved = searchHybrid();
+        if (!solved){
+            undoTrail(0);
+        }
+        trail.clear();
+        return solved;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::countHybrid(const unsigned int& limit, unsigned int& count, const uint16_t& depth){
+        ++steps;
+        countNode(depth);
+        int index = pickBranchSquare();
+        if (index == -1){
+            return ++count >= limit;
+        }
+
+        std::size_t mark = trail.size();
         for (uint8_t val : grid[index].getPossibles()){
-            //Check square checks ensures validity before assigning value
-            if (checkSquare(index, val) && assignSquare(index, val)){
-                if (solveBacktrack()){
+            bool open = placeTrailed(index, val) && propagateSingles();
+            bool done = open && countHybrid(limit, count, depth + 1);
+            undoTrail(mark);
+            if (done){
+                return true;
+            }
+            if (open){
+                countBacktrack();
+            }
+        }
+        return false;
+    }
+
+    template <int BoxSize>
+    unsigned int BasicSudoku<BoxSize>::countSolutions(const unsigned int& limit){
+        unsigned int count = 0;
+        if (!logical || limit == 0){
+            return count;
+        }
+        dropPaused();
+        //Moves made with place() stay on the trail below mark
+        std::size_t mark = trail.size();
+        trail.reserve(mark + grid_size*(peer_count + 1));
+        timeSearch([this, &limit, &count] {
+            return propagateSingles() && countHybrid(limit, count);
+        });
+        undoTrail(mark);
+        return count;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::solveParallel(const unsigned int& threads){
+        if (!logical){
+            return false;
+        }
+        dropPaused();
+        moves.clear();
+        solver = HYBRID;
+        trail.clear();
+        trail.reserve(grid_size*(peer_count + 1));
+        if (!propagateSingles()){
+            undoTrail(0);
+            return false;
+        }
+        trail.clear();
+
+        //Expand the first few branch squares breadth first until every thread has several subtrees
+        //Copies start with an empty trail and borrow this one while they place, so splitting doesn't grow a trail per child
+        std::size_t target = std::size_t(threads)*split_subtrees_per_thread;
+        std::vector<BasicSudoku> frontier(1, *this);
+        uint16_t depth = 0;
+        for (; depth < max_split_depth && frontier.size() < target; ++depth){
+            std::vector<BasicSudoku> next;
+            for (BasicSudoku& node : frontier){
+                ++steps;
+                countNode(depth);
+                int index = node.pickBranchSquare();
+                if (index == -1){
+                    //Solved while splitting
+                    grid = node.grid;
+                    rowUsed = node.rowUsed;
+                    colUsed = node.colUsed;
+                    boxUsed = node.boxUsed;
                     return true;
                 }
-                else{
-                    //Revert back to initial state
-                    grid[index].setToOriginalValue();
+                for (uint8_t val : node.grid[index].getPossibles()){
+                    BasicSudoku child = node;
+                    child.trail.swap(trail);
+                    bool open = child.placeTrailed(index, val) && child.propagateSingles();
+                    child.trail.clear();
+                    child.trail.swap(trail);
+                    if (open){
+                        next.push_back(std::move(child));
+                    }
                 }
             }
+            frontier.swap(next);
         }
-        return false;
+
+        //Search the subtrees on their own copies, the first solution found cancels the rest
+        //Each worker has one trail reserved up front for all of its subtrees
+        std::atomic<bool> found{false};
+        std::atomic<std::size_t> winner{frontier.size()};
+        std::atomic<unsigned int> nodes{0};
+        for (BasicSudoku& node : frontier){
+            node.stats = SolveStats();
+        }
+        std::vector<std::vector<TrailEntry>> trails(std::max<std::size_t>(1, std::min<std::size_t>(threads, frontier.size())));
+        for (std::vector<TrailEntry>& workerTrail : trails){
+            workerTrail.reserve(grid_size*(peer_count + 1));
+        }
+        timeSearch([&] {
+            parallelFor(frontier.size(), threads, [&] (unsigned int worker, std::size_t i){
+                BasicSudoku& node = frontier[i];
+                if (found.load(std::memory_order_relaxed)){
+                    return;
+                }
+                node.steps = 0;
+                node.cancelled = &found;
+                node.trail.swap(trails[worker]);
+                if (node.searchHybrid(depth) && !found.exchange(true)){
+                    winner = i;
+                }
+                node.trail.clear();
+                node.trail.swap(trails[worker]);
+                nodes += node.steps;
+            });
+            return true;
+        });
+        steps += nodes;
+        //Only counts are kept, the subtrees were searched at the same time
+        for (const BasicSudoku& node : frontier){
+            stats.addCounts(node.stats);
+        }
+
+        if (winner == frontier.size()){
+            return false;
+        }
+        const BasicSudoku& solution = frontier[winner];
+        grid = solution.grid;
+        rowUsed = solution.rowUsed;
+        colUsed = solution.colUsed;
+        boxUsed = solution.boxUsed;
+        return true;
+    }
+
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::solveDlx(){
+        solver = DLX;
+        //One matrix per thread, its node pool is allocated by the first solve and reused by every solve after it
+        //load() rewinds it, so a batch of DLX solves doesn't touch the heap after the first puzzle
+        static thread_local BasicDancingLinks<BoxSize> dlx;
+        bool solved = false;
+        if (dlx.load(grid)){
+            SolveStatus status = limits == nullptr ? (dlx.solve() ? SOLVED : NO_SOLUTION) : dlx.solve(*limits);
+            solved = status == SOLVED;
+            stopped = status == NO_SOLUTION ? SOLVED : status;
+        }
+        steps += dlx.getSteps();
+        if constexpr (solve_stats_enabled){
+            stats.nodes += dlx.getSteps();
+            stats.backtracks += dlx.getBacktracks();
+            stats.maxDepth = std::max(stats.maxDepth, dlx.getMaxDepth());
+        }
+        if (!solved){
+            return false;
+        }
+
+        //Solution values skip assignSquare, so rebuild the masks from the solved grid
+        dlx.writeSolution(grid);
+        rowUsed.fill(0);
+        colUsed.fill(0);
+        boxUsed.fill(0);
+        for (index_type i = 0; i < grid_size; ++i){
+            markUsed(i, grid[i].getElement());
+        }
+        return true;
     }
 
-    //TODO: Implement new solve methods and utilize solver to determine which method to use
-    bool Sudoku::solve(){
+    template <int BoxSize>
+    bool BasicSudoku<BoxSize>::solve(){
         //Avoid trying to solve illogical grid
         if (!logical){
             return false;
         }
-        else{
-            return solveBacktrack();
-        }
+        //Solving keeps whatever moves were made, they can't be taken back afterwards
+        dropPaused();
+        moves.clear();
+        trail.clear();
+        return timeSearch([this] {
+            switch (solver){
+                case RULES:
+                    return solveRules();
+                case HYBRID:
+                    return solveHybrid();
+                case DLX:
+                    return solveDlx();
+                case BACKTRACK:
+                case NONE:
+                default:
+                    return solveBacktrack();
+            }
+        });
     }
+
+    template <int BoxSize>
+    SolveStatus BasicSudoku<BoxSize>::solve(const SolveLimits& limits){
+        this->limits = &limits;
+        limitStart = steps;
+        stopped = SOLVED;
+        bool solved = solve();
+        SolveStatus status = solved ? SOLVED : stopped == SOLVED ? NO_SOLUTION : stopped;
+        //Only this solve is limited
+        this->limits = nullptr;
+        stopped = SOLVED;
+        return status;
+    }
+
+    template <int BoxSize>
+    SolveStatus BasicSudoku<BoxSize>::solve(const std::chrono::steady_clock::time_point& deadline){
+        SolveLimits limits;
+        limits.deadline = deadline;
+        return solve(limits);
+    }
+
+    template class BasicSudoku<2>;
+    template class BasicSudoku<3>;
+    template class BasicSudoku<4>;
+    template class BasicSudoku<5>;
 } //End namespace sudoku
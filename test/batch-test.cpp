@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include "sudoku/batch.hpp"
+
+#include <sstream>
+
+using namespace std;
+using namespace sudoku;
+
+TEST(PuzzleReaderTest, LinePerPuzzle){
+    ifstream input;
+    input.open("sudoku-test-lines.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-lines.txt";
+    PuzzleReader reader(input);
+
+    vector<string> puzzles;
+    string puzzle;
+    while (reader.next(puzzle)){
+        puzzles.push_back(puzzle);
+    }
+    ASSERT_EQ(puzzles.size(), 5) << "Did not read every puzzle";
+    EXPECT_EQ(reader.getCount(), 5) << "Reader count not 5";
+    for (const string& p : puzzles){
+        EXPECT_EQ(p.size(), grid_size) << "Puzzle not size 81";
+    }
+    EXPECT_EQ(puzzles[0], puzzles[1]) << "'.' and '0' blanks not read the same";
+    EXPECT_EQ(puzzles[0], puzzles[4]) << "Line and titled layouts not read the same";
+    EXPECT_EQ(puzzles[0].substr(0, 9), "3-----4--") << "Blanks not normalized to '-'";
+    EXPECT_FALSE(reader.next(puzzle)) << "Reader returned a puzzle past the end";
+}
+
+TEST(PuzzleReaderTest, TitledGrids){
+    ifstream input;
+    input.open("sudoku-test-too-large.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-too-large.txt";
+    PuzzleReader reader(input);
+    string puzzle;
+    EXPECT_TRUE(reader.next(puzzle)) << "First titled grid not read";
+    EXPECT_EQ(puzzle.substr(0, 9), "83---7---") << "First titled grid not read in order";
+    EXPECT_TRUE(reader.next(puzzle)) << "Second titled grid not read";
+    EXPECT_EQ(puzzle.substr(0, 9), "4--2-----") << "Second titled grid not read in order";
+    EXPECT_FALSE(reader.next(puzzle)) << "Reader returned a third grid";
+}
+
+TEST(BatchTest, SolveBatch){
+    ifstream input;
+    input.open("sudoku-test-lines.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-lines.txt";
+
+    vector<size_t> order;
+    vector<bool> results;
+    BatchResult result = solveBatch(input, HYBRID, [&](size_t i, const Sudoku& s, bool solved){
+        order.push_back(i);
+        results.push_back(solved);
+        if (solved){
+            for (uint8_t j = 0; j < grid_size; ++j){
+                EXPECT_FALSE(s.getGrid()[j].isBlank()) << "Solved puzzle " << i << " has blank square";
+            }
+        }
+    });
+    EXPECT_EQ(result.solved, 4) << "Batch solved count not 4";
+    EXPECT_EQ(result.failed, 1) << "Batch failed count not 1";
+    EXPECT_EQ(result.total(), 5) << "Batch total not 5";
+    EXPECT_EQ(order, vector<size_t>({0, 1, 2, 3, 4})) << "Callback not called in input order";
+    EXPECT_FALSE(results[2]) << "Conflicting puzzle not reported as failed";
+    EXPECT_GE(result.puzzlesPerSecond(), 0) << "Puzzles per second negative";
+}
+
+TEST(BatchTest, ReuseSolver){
+    ifstream input;
+    input.open("sudoku-test-too-large.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-too-large.txt";
+    PuzzleReader reader(input);
+    string first, second;
+    ASSERT_TRUE(reader.next(first) && reader.next(second));
+
+    //A reused solver has to give the same answer as a fresh one
+    Sudoku reused;
+    reused.setSolverType(BACKTRACK);
+    ASSERT_TRUE(reused.load(first) && reused.solve());
+    ASSERT_TRUE(reused.load(second));
+    EXPECT_EQ(reused.getSteps(), 0) << "Steps not reset by load";
+    ASSERT_TRUE(reused.solve());
+
+    Sudoku fresh;
+    fresh.setSolverType(BACKTRACK);
+    ASSERT_TRUE(fresh.load(second) && fresh.solve());
+    EXPECT_EQ(reused.getSteps(), fresh.getSteps()) << "Reused solver took a different path";
+    for (uint8_t i = 0; i < grid_size; ++i){
+        EXPECT_EQ(reused.getGrid()[i].getElement(), fresh.getGrid()[i].getElement()) << "Reused solver solution differs at " << i;
+    }
+    EXPECT_FALSE(reused.load("123")) << "Load of short puzzle logical";
+}
+
+TEST(BatchTest, SolveBatchParallel){
+    //Enough copies to span several windows and workers
+    string text;
+    {
+        ifstream input;
+        input.open("sudoku-test-lines.txt");
+        ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-lines.txt";
+        text.assign(istreambuf_iterator<char>(input), istreambuf_iterator<char>());
+    }
+    string many;
+    for (int i = 0; i < 1000; ++i){
+        many += text + "\n";
+    }
+
+    vector<string> serial;
+    istringstream serialIn(many);
+    BatchResult serialResult = solveBatch(serialIn, HYBRID, [&](size_t i, const Sudoku& s, bool solved){
+        string line;
+        s.appendLine(line);
+        serial.push_back(line);
+    });
+
+    vector<string> parallel;
+    vector<size_t> order;
+    istringstream parallelIn(many);
+    BatchResult parallelResult = solveBatchParallel(parallelIn, HYBRID, 4, [&](size_t i, string_view line, bool solved){
+        order.push_back(i);
+        parallel.emplace_back(line);
+    });
+
+    EXPECT_EQ(parallelResult.solved, serialResult.solved) << "Parallel solved count differs";
+    EXPECT_EQ(parallelResult.failed, serialResult.failed) << "Parallel failed count differs";
+    EXPECT_EQ(parallelResult.total(), 5000) << "Parallel total not 5000";
+    ASSERT_EQ(parallel.size(), serial.size()) << "Parallel result count differs";
+    for (size_t i = 0; i < parallel.size(); ++i){
+        ASSERT_EQ(order[i], i) << "Parallel results not in input order";
+        ASSERT_EQ(parallel[i], serial[i]) << "Parallel result " << i << " differs";
+    }
+
+    istringstream none("");
+    EXPECT_EQ(solveBatchParallel(none, HYBRID, 4).total(), 0) << "Parallel total not 0 for no puzzles";
+}
+
+TEST(LineWriterTest, FlushInBlocks){
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr) << "Failed to open a temp file";
+    auto written = [file] (){
+        fflush(file);
+        return long(ftell(file));
+    };
+
+    string expected;
+    {
+        //A small limit so lines are held and then written out a block at a time
+        LineWriter writer(file, 2*grid_size);
+        string line(grid_size, '1');
+        writer.write(line);
+        expected += line + "\n";
+        EXPECT_EQ(written(), 0) << "Line written out before the buffer filled";
+        writer.write(line);
+        expected += line + "\n";
+        EXPECT_EQ(written(), long(expected.size())) << "Full buffer not written out";
+        writer.write("end");
+        expected += "end\n";
+    }
+    //The rest goes out when the writer is done
+    ASSERT_EQ(written(), long(expected.size())) << "Lines left in the buffer";
+    rewind(file);
+    string text(expected.size(), '\0');
+    EXPECT_EQ(fread(text.data(), 1, text.size(), file), text.size()) << "Failed to read back the temp file";
+    EXPECT_EQ(text, expected) << "Lines written out differently";
+    fclose(file);
+}
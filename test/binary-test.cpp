@@ -0,0 +1,169 @@
+#include "gtest/gtest.h"
+#include "sudoku/batch.hpp"
+#include "sudoku/binary.hpp"
+#include "sudoku/loader.hpp"
+
+#include <sstream>
+
+using namespace std;
+using namespace sudoku;
+
+//Every puzzle in sudoku-test-lines.txt as its own string
+static vector<string> testPuzzles(){
+    ifstream input;
+    input.open("sudoku-test-lines.txt");
+    PuzzleReader reader(input);
+    vector<string> puzzles;
+    string puzzle;
+    while (reader.next(puzzle)){
+        puzzles.push_back(puzzle);
+    }
+    return puzzles;
+}
+
+TEST(BinaryTest, PackBoard){
+    vector<string> puzzles = testPuzzles();
+    ASSERT_EQ(puzzles.size(), 5) << "Failed to read sudoku-test-lines.txt";
+
+    Sudoku s1;
+    s1.setSolverType(HYBRID);
+    ASSERT_TRUE(s1.load(puzzles[0]) && s1.solve()) << "Failed to solve first puzzle";
+    uint8_t record[packed_values_size + packed_givens_size];
+    packBoard(s1.getBoard(), record, true);
+    Board board;
+    ASSERT_TRUE(unpackBoard(record, board, true)) << "Packed board not unpacked";
+    EXPECT_EQ(board.cells, s1.getBoard().cells) << "Solved board with givens not the same after packing";
+
+    //Without the bitmap every value comes back as a given
+    ASSERT_TRUE(packPuzzle(puzzles[0], record)) << "Puzzle not packed";
+    ASSERT_TRUE(unpackBoard(record, board, false)) << "Packed puzzle not unpacked";
+    Sudoku loaded, text;
+    loaded.load(board);
+    text.load(puzzles[0]);
+    EXPECT_EQ(loaded.getBoard().cells, text.getBoard().cells) << "Packed puzzle loads differently from text";
+    string line;
+    appendBoardLine(board, line);
+    EXPECT_EQ(line, puzzles[0]) << "Packed puzzle not written back as the same line";
+
+    EXPECT_FALSE(packPuzzle("123", record)) << "Short puzzle packed";
+    record[0] = 0xff;
+    EXPECT_FALSE(unpackBoard(record, board, false)) << "Value 15 unpacked";
+}
+
+TEST(BinaryTest, WriteAndRead){
+    vector<string> puzzles = testPuzzles();
+    ASSERT_EQ(puzzles.size(), 5) << "Failed to read sudoku-test-lines.txt";
+
+    stringstream file;
+    BinaryWriter writer(file);
+    for (const string& puzzle : puzzles){
+        EXPECT_TRUE(writer.add(puzzle)) << "Puzzle not written";
+    }
+    EXPECT_FALSE(writer.add("123")) << "Short puzzle written";
+    ASSERT_TRUE(writer.finish()) << "Writer failed";
+    EXPECT_EQ(writer.getCount(), 5) << "Writer count not 5";
+
+    string data = file.str();
+    EXPECT_EQ(data.size(), binary_header_size + 5*packed_values_size) << "File not header plus fixed size records";
+    BinaryReader reader(data);
+    ASSERT_TRUE(reader.isValid()) << "Written file not valid";
+    EXPECT_FALSE(reader.hasGivens()) << "Puzzle file has a givens bitmap";
+    EXPECT_EQ(reader.size(), 5) << "Reader count not 5";
+
+    //Random access, back to front
+    Board board;
+    for (size_t k = puzzles.size(); k-- > 0;){
+        ASSERT_TRUE(reader.get(k, board)) << "Puzzle " << k << " not read";
+        string line;
+        appendBoardLine(board, line);
+        EXPECT_EQ(line, puzzles[k]) << "Puzzle " << k << " differs";
+    }
+    EXPECT_FALSE(reader.get(5, board)) << "Read past the last puzzle";
+
+    string cut = data.substr(0, data.size() - 1);
+    EXPECT_FALSE(BinaryReader(cut).isValid()) << "Truncated file valid";
+    EXPECT_FALSE(BinaryReader("SDK").isValid()) << "Short header valid";
+    EXPECT_FALSE(BinaryReader::isBinary(puzzles[0])) << "Text puzzle taken as binary";
+}
+
+TEST(BinaryTest, Givens){
+    vector<string> puzzles = testPuzzles();
+    ASSERT_EQ(puzzles.size(), 5) << "Failed to read sudoku-test-lines.txt";
+
+    Sudoku s1;
+    s1.setSolverType(HYBRID);
+    ASSERT_TRUE(s1.load(puzzles[3]) && s1.solve()) << "Failed to solve puzzle";
+    stringstream file;
+    BinaryWriter writer(file, true);
+    writer.add(s1.getBoard());
+    ASSERT_TRUE(writer.add(puzzles[3])) << "Text puzzle not written to a givens file";
+    ASSERT_TRUE(writer.finish()) << "Writer failed";
+
+    string data = file.str();
+    BinaryReader reader(data);
+    ASSERT_TRUE(reader.isValid() && reader.hasGivens()) << "Givens file not read";
+    Board solved, puzzle;
+    ASSERT_TRUE(reader.get(0, solved) && reader.get(1, puzzle)) << "Givens records not read";
+    for (int i = 0; i < grid_size; ++i){
+        EXPECT_EQ(solved[i].isGiven(), !puzzle[i].isBlank()) << "Given bit lost at " << i;
+        EXPECT_TRUE(puzzle[i].isBlank() || puzzle[i].getElement() == solved[i].getElement()) << "Solution does not match puzzle at " << i;
+    }
+}
+
+TEST(BinaryTest, SolveBatch){
+    MappedFile mapped("sudoku-test-lines.txt");
+    ASSERT_TRUE(mapped.isOpen()) << "Failed to map sudoku-test-lines.txt";
+    stringstream file;
+    BinaryWriter writer(file);
+    PuzzleScanner scanner(mapped.view());
+    string_view record;
+    while (scanner.next(record)){
+        writer.add(record);
+    }
+    ASSERT_TRUE(writer.finish()) << "Writer failed";
+    string data = file.str();
+
+    vector<string> text, binary;
+    auto collect = [] (vector<string>& lines){
+        return [&lines] (size_t i, const Sudoku& s, bool solved){
+            lines.emplace_back();
+            s.appendLine(lines.back());
+        };
+    };
+    BatchResult textResult = solveBatch(mapped.view(), DLX, collect(text));
+    BinaryReader reader(data);
+    BatchResult binaryResult = solveBatch(reader, DLX, collect(binary));
+    EXPECT_EQ(binaryResult.solved, textResult.solved) << "Solved count differs from text batch";
+    EXPECT_EQ(binaryResult.failed, textResult.failed) << "Failed count differs from text batch";
+    EXPECT_EQ(binary, text) << "Solutions differ from text batch";
+
+    vector<string> parallel;
+    BinaryReader parallelReader(data);
+    solveBatchParallel(parallelReader, DLX, 4, [&parallel] (size_t i, string_view line, bool solved){
+        parallel.emplace_back(line);
+    });
+    EXPECT_EQ(parallel, text) << "Parallel solutions differ from text batch";
+
+    //A bad record is skipped, the puzzles after it keep their record numbers
+    data[binary_header_size + packed_values_size] = char(0xff);
+    for (unsigned int threads : {1, 4}){
+        BinaryReader badReader(data);
+        vector<size_t> positions;
+        vector<string> lines;
+        BatchResult result = solveBatchParallel(badReader, DLX, threads, [&] (size_t i, string_view line, bool solved){
+            positions.push_back(i);
+            lines.emplace_back(line);
+        });
+        EXPECT_EQ(result.total(), text.size() - 1) << "Bad record not skipped with " << threads << " threads";
+        EXPECT_EQ(positions, vector<size_t>({0, 2, 3, 4})) << "Positions not record numbers with " << threads << " threads";
+        EXPECT_EQ(badReader.getCount(), text.size()) << "Skipped record not counted with " << threads << " threads";
+        ASSERT_EQ(lines.size(), 4) << "Wrong number of lines with " << threads << " threads";
+        EXPECT_EQ(lines[1], text[2]) << "Puzzle after the bad record differs with " << threads << " threads";
+    }
+    BinaryReader badReader(data);
+    vector<size_t> positions;
+    solveBatch(badReader, DLX, [&positions] (size_t i, const Sudoku& s, bool solved){
+        positions.push_back(i);
+    });
+    EXPECT_EQ(positions, vector<size_t>({0, 2, 3, 4})) << "Serial positions not record numbers";
+}
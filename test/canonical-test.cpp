@@ -0,0 +1,176 @@
+#include "gtest/gtest.h"
+#include "sudoku/batch.hpp"
+#include "sudoku/canonical.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+using namespace std;
+using namespace sudoku;
+
+//Every puzzle in sudoku-test-canonical.txt loaded into a board, easy, hard, and minimal puzzles that are all different
+static vector<Board> testBoards(){
+    ifstream input;
+    input.open("sudoku-test-canonical.txt");
+    PuzzleReader reader(input);
+    vector<Board> boards;
+    string puzzle;
+    Sudoku s1;
+    while (reader.next(puzzle)){
+        s1.load(puzzle);
+        //Only the givens, load fills in singles
+        Board board = s1.getBoard();
+        for (int i = 0; i < grid_size; ++i){
+            if (!board[i].isGiven()){
+                board.cells[i] = blank_element_value;
+            }
+        }
+        boards.push_back(board);
+    }
+    return boards;
+}
+
+static string keyOfBoard(const Board& board){
+    string key;
+    for (int i = 0; i < grid_size; ++i){
+        key.push_back(board[i].isBlank() ? '0' : char('0' + board[i].getElement()));
+    }
+    return key;
+}
+
+//Shuffles bands, rows in bands, stacks, columns in stacks, and digits
+static Transform randomTransform(mt19937& random){
+    Transform transform;
+    transform.transpose = random() % 2;
+    for (auto* lines : {&transform.rows, &transform.cols}){
+        array<uint8_t, box_size> bands{0, 1, 2};
+        shuffle(bands.begin(), bands.end(), random);
+        for (int b = 0; b < box_size; ++b){
+            array<uint8_t, box_size> inner{0, 1, 2};
+            shuffle(inner.begin(), inner.end(), random);
+            for (int k = 0; k < box_size; ++k){
+                (*lines)[b*box_size + k] = bands[b]*box_size + inner[k];
+            }
+        }
+    }
+    shuffle(transform.relabel.begin() + 1, transform.relabel.end(), random);
+    return transform;
+}
+
+TEST(CanonicalTest, Transforms){
+    vector<Board> boards = testBoards();
+    ASSERT_EQ(boards.size(), 9) << "Failed to read sudoku-test-canonical.txt";
+    mt19937 random(17);
+    for (const Board& board : boards){
+        Transform transform = randomTransform(random);
+        Board moved = applyTransform(board, transform);
+        EXPECT_EQ(invertTransform(moved, transform).cells, board.cells) << "Inverse did not give back the board";
+        Sudoku s1;
+        EXPECT_TRUE(s1.load(moved)) << "Transformed puzzle not logical";
+    }
+}
+
+TEST(CanonicalTest, SameKey){
+    vector<Board> boards = testBoards();
+    ASSERT_EQ(boards.size(), 9) << "Failed to read sudoku-test-canonical.txt";
+    mt19937 random(18);
+    vector<string> keys;
+    for (const Board& board : boards){
+        CanonicalForm form = canonicalize(board);
+        ASSERT_TRUE(form.exact) << "Search gave up on a test puzzle";
+        EXPECT_EQ(keyOfBoard(applyTransform(board, form.transform)), form.key) << "Key not the transformed board";
+        for (int k = 0; k < 20; ++k){
+            Board moved = applyTransform(board, randomTransform(random));
+            EXPECT_EQ(canonicalize(moved).key, form.key) << "Equivalent puzzle got a different key";
+        }
+        keys.push_back(form.key);
+    }
+    sort(keys.begin(), keys.end());
+    EXPECT_EQ(unique(keys.begin(), keys.end()), keys.end()) << "Different puzzles share a key";
+
+    //Every orientation of a blank grid ties, so the search gives up and only relabels
+    CanonicalForm blank = canonicalize(Board(), 1000);
+    EXPECT_FALSE(blank.exact) << "Blank grid search did not give up";
+    EXPECT_EQ(blank.key, string(grid_size, '0')) << "Blank grid key not all blanks";
+
+    //Every orientation of a solved grid ties on the first row too, but it still gets an exact key
+    Sudoku solver;
+    solver.setSolverType(DLX);
+    ASSERT_TRUE(solver.load(boards[0]) && solver.solve()) << "Failed to solve a test puzzle";
+    CanonicalForm solved = canonicalize(solver.getBoard(), 1000);
+    EXPECT_TRUE(solved.exact) << "Solved grid search gave up";
+    for (int k = 0; k < 5; ++k){
+        Board moved = applyTransform(solver.getBoard(), randomTransform(random));
+        EXPECT_EQ(canonicalize(moved).key, solved.key) << "Equivalent solved grid got a different key";
+    }
+}
+
+TEST(SolutionCacheTest, Hits){
+    vector<Board> boards = testBoards();
+    ASSERT_EQ(boards.size(), 9) << "Failed to read sudoku-test-canonical.txt";
+    mt19937 random(19);
+    SolutionCache cache;
+    for (const Board& board : boards){
+        Board solution;
+        ASSERT_TRUE(cache.solve(board, solution)) << "Failed to solve a test puzzle";
+    }
+    EXPECT_EQ(cache.getMisses(), 9) << "First solves not all misses";
+
+    for (const Board& board : boards){
+        Board moved = applyTransform(board, randomTransform(random));
+        Sudoku s1;
+        s1.setSolverType(DLX);
+        ASSERT_TRUE(s1.load(moved) && s1.solve()) << "Failed to solve a transformed puzzle";
+        Board solution;
+        ASSERT_TRUE(cache.solve(moved, solution)) << "Cached solve failed";
+        EXPECT_EQ(solution.cells, s1.getBoard().cells) << "Cached solution differs from solving the puzzle";
+    }
+    EXPECT_EQ(cache.getHits(), 9) << "Transformed puzzles not all hits";
+    EXPECT_EQ(cache.size(), 9) << "Cache size not 9";
+}
+
+TEST(SolutionCacheTest, EvictAndSave){
+    vector<Board> boards = testBoards();
+    ASSERT_EQ(boards.size(), 9) << "Failed to read sudoku-test-canonical.txt";
+    SolutionCache cache(2);
+    Board solution;
+    bool solvable = false;
+    cache.solve(boards[0], solution);
+    cache.solve(boards[1], solution);
+    EXPECT_TRUE(cache.find(boards[0], solution, solvable) && solvable) << "First puzzle not found";
+    EXPECT_FALSE(cache.find(boards[2], solution, solvable)) << "Puzzle found before it was solved";
+    EXPECT_EQ(cache.getHits(), 1) << "Find hit not counted";
+    EXPECT_EQ(cache.getMisses(), 3) << "Find miss not counted";
+    cache.solve(boards[2], solution);
+    //The second puzzle was used least recently
+    EXPECT_EQ(cache.size(), 2) << "Cache grew past its capacity";
+    EXPECT_FALSE(cache.find(boards[1], solution, solvable)) << "Least recently used puzzle not evicted";
+    EXPECT_TRUE(cache.find(boards[0], solution, solvable)) << "Recently used puzzle evicted";
+
+    //No solution is cached too
+    Board unsolvable = boards[3];
+    int blank = 0;
+    while (unsolvable[blank].isGiven()){
+        ++blank;
+    }
+    for (uint8_t val = 1; val <= number_of_element_values; ++val){
+        Sudoku s1;
+        unsolvable.cells[blank] = val | Board::given_bit;
+        if (s1.load(unsolvable) && s1.countSolutions(1) == 0){
+            break;
+        }
+    }
+    EXPECT_FALSE(cache.solve(unsolvable, solution)) << "Unsolvable puzzle solved";
+    EXPECT_TRUE(cache.find(unsolvable, solution, solvable)) << "Unsolvable puzzle not cached";
+    EXPECT_FALSE(solvable) << "Unsolvable puzzle cached as solvable";
+
+    ASSERT_TRUE(cache.save("sudoku-test-cache.txt")) << "Failed to save the cache";
+    SolutionCache loaded(2);
+    ASSERT_TRUE(loaded.load("sudoku-test-cache.txt")) << "Failed to load the cache";
+    remove("sudoku-test-cache.txt");
+    EXPECT_EQ(loaded.size(), 2) << "Loaded cache size not 2";
+    EXPECT_TRUE(loaded.find(unsolvable, solution, solvable) && !solvable) << "Unsolvable puzzle not loaded";
+    EXPECT_TRUE(loaded.find(boards[0], solution, solvable) && solvable) << "Solved puzzle not loaded";
+    EXPECT_FALSE(loaded.load("no-such-file.txt")) << "Missing file loaded";
+}
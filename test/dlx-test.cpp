@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+#include "sudoku/dlx.hpp"
+
+using namespace std;
+using namespace sudoku;
+
+TEST(DancingLinksTest, SolveGrid){
+    ifstream input;
+    input.open("sudoku-test1.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test1.txt";
+    Sudoku s1(input);
+    ifstream solution;
+    solution.open("sudoku-test1-solved.txt");
+    ASSERT_TRUE(solution.is_open()) << "Failed to open sudoku-test1-solved.txt";
+    Sudoku solved(solution);
+
+    Board grid = s1.getBoard();
+    DancingLinks dlx;
+    ASSERT_TRUE(dlx.load(grid)) << "Load of valid grid failed";
+    EXPECT_TRUE(dlx.solve()) << "Solve of valid grid failed";
+    EXPECT_TRUE(dlx.writeSolution(grid)) << "Write solution failed after successful solve";
+    for (int i = 0; i < grid_size; i++){
+        EXPECT_EQ(grid[i].getElement(), solved.getGrid()[i].getElement()) << "DLX solution not correct";
+        EXPECT_EQ(grid[i].isGiven(), s1.getGrid()[i].isGiven()) << "DLX solution changed givens";
+    }
+
+    //Reusing the same pool for another grid
+    Board blank;
+    ASSERT_TRUE(dlx.load(blank)) << "Load of blank grid failed";
+    EXPECT_TRUE(dlx.solve()) << "Solve of blank grid failed";
+    EXPECT_TRUE(dlx.writeSolution(blank));
+    for (int i = 0; i < grid_size; i++){
+        EXPECT_FALSE(blank[i].isBlank()) << "DLX left blank square at " << i;
+    }
+
+    //A solve stopped by a limit leaves nothing behind for the next grid
+    SolveLimits limits;
+    limits.maxNodes = 1;
+    ASSERT_TRUE(dlx.load(s1.getBoard())) << "Load of valid grid failed";
+    EXPECT_EQ(dlx.solve(limits), NODE_LIMIT) << "Node limit not hit";
+    EXPECT_FALSE(dlx.writeSolution(grid)) << "Write solution succeeded after a stopped solve";
+    ASSERT_TRUE(dlx.load(s1.getBoard())) << "Load after a stopped solve failed";
+    EXPECT_TRUE(dlx.solve()) << "Solve after a stopped solve failed";
+}
+
+TEST(DancingLinksTest, SearchCounts){
+    ifstream input;
+    input.open("sudoku-test-too-large.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-too-large.txt";
+    Sudoku s1(input);
+    int blanks = 0;
+    for (int i = 0; i < grid_size; i++){
+        blanks += s1.getGrid()[i].isBlank();
+    }
+
+    DancingLinks dlx;
+    ASSERT_TRUE(dlx.load(s1.getBoard())) << "Load of valid grid failed";
+    ASSERT_TRUE(dlx.solve()) << "Solve of valid grid failed";
+    EXPECT_GT(dlx.getBacktracks(), 0) << "Hard grid solved without backtracking";
+    EXPECT_EQ(dlx.getMaxDepth(), blanks) << "Solved path not one pick per blank square";
+    EXPECT_EQ(dlx.getBacktracks(), dlx.getSteps() - 1 - dlx.getMaxDepth()) << "Every node but the solved path should be undone";
+
+    //A stopped solve unwinds without counting backtracks
+    SolveLimits limits;
+    limits.maxNodes = 5;
+    ASSERT_TRUE(dlx.load(s1.getBoard())) << "Reload of valid grid failed";
+    EXPECT_EQ(dlx.getBacktracks(), 0) << "Backtracks not reset by load";
+    EXPECT_EQ(dlx.solve(limits), NODE_LIMIT) << "Node limit not hit";
+    EXPECT_LE(dlx.getMaxDepth(), 4) << "Five nodes went more than four picks deep";
+    EXPECT_EQ(dlx.getBacktracks(), 0) << "Unwinding a stopped solve counted as backtracks";
+}
+
+TEST(DancingLinksTest, InvalidGrid){
+    DancingLinks dlx;
+    Board grid;
+    grid.set(0, Square(5, true));
+    grid.set(1, Square(5, true));
+    EXPECT_FALSE(dlx.load(grid)) << "Load of conflicting givens succeeded";
+    Board out;
+    EXPECT_FALSE(dlx.writeSolution(out)) << "Write solution succeeded without a solve";
+}
+
+TEST(DancingLinksTest, SudokuMethod){
+    ifstream input;
+    input.open("sudoku-test-too-large.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-too-large.txt";
+    Sudoku s1(input, DLX);
+    EXPECT_TRUE(s1.solve()) << "DLX solve method not TRUE";
+    for (uint8_t i = 0; i < grid_size; i++){
+        EXPECT_FALSE(s1.getGrid()[i].isBlank()) << "DLX solve left blank square at " << i;
+        EXPECT_TRUE(s1.checkSquare(i)) << "DLX solve placed invalid value at " << i;
+    }
+    EXPECT_GT(s1.getSteps(), 0) << "DLX solve did not count steps";
+}
@@ -0,0 +1,42 @@
+#include "gtest/gtest.h"
+#include "sudoku/generator.hpp"
+
+using namespace std;
+using namespace sudoku;
+
+TEST(GeneratorTest, FillGrid){
+    Generator generator(1);
+    Board grid = generator.fillGrid();
+    Sudoku s1;
+    ASSERT_TRUE(s1.load(grid)) << "Filled grid not logical";
+    for (int i = 0; i < grid_size; ++i){
+        EXPECT_TRUE(grid[i].isGiven()) << "Filled square " << i << " not a given";
+    }
+    EXPECT_EQ(s1.countSolutions(2), 1) << "Filled grid not solved";
+    EXPECT_NE(Generator(2).fillGrid().cells, grid.cells) << "Different seeds filled the same grid";
+}
+
+TEST(GeneratorTest, Difficulty){
+    //Few puzzles each, the harder grades take many tries
+    const size_t counts[] = {4, 2, 1, 2};
+    for (int d = EASY; d < DIFFICULTY_COUNT; ++d){
+        vector<Board> puzzles = generatePuzzles(counts[d], Difficulty(d), 5, 2);
+        ASSERT_EQ(puzzles.size(), counts[d]) << "Wrong puzzle count for difficulty " << d;
+        for (const Board& puzzle : puzzles){
+            Sudoku s1;
+            ASSERT_TRUE(s1.load(puzzle)) << "Generated puzzle not logical";
+            EXPECT_EQ(s1.countSolutions(2), 1) << "Generated puzzle does not have one solution";
+            EXPECT_EQ(s1.grade(), d) << "Generated puzzle graded wrong";
+        }
+    }
+}
+
+TEST(GeneratorTest, Seed){
+    vector<Board> serial = generatePuzzles(6, EASY, 11, 1);
+    vector<Board> parallel = generatePuzzles(6, EASY, 11, 4);
+    vector<Board> other = generatePuzzles(6, EASY, 12, 1);
+    for (size_t k = 0; k < serial.size(); ++k){
+        EXPECT_EQ(serial[k].cells, parallel[k].cells) << "Puzzle " << k << " depends on the thread count";
+        EXPECT_NE(serial[k].cells, other[k].cells) << "Puzzle " << k << " the same for a different seed";
+    }
+}
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+#include "sudoku/batch.hpp"
+#include "sudoku/loader.hpp"
+
+#include <sstream>
+
+using namespace std;
+using namespace sudoku;
+
+TEST(MappedFileTest, Open){
+    MappedFile mapped("sudoku-test-lines.txt");
+    ASSERT_TRUE(mapped.isOpen()) << "Failed to map sudoku-test-lines.txt";
+
+    ifstream input;
+    input.open("sudoku-test-lines.txt", ios::binary);
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-lines.txt";
+    string text(istreambuf_iterator<char>(input), (istreambuf_iterator<char>()));
+    EXPECT_EQ(mapped.view(), text) << "Mapped file differs from the file read in";
+
+    MappedFile empty("sudoku-test-empty.txt");
+    EXPECT_TRUE(empty.isOpen()) << "Empty file not open";
+    EXPECT_TRUE(empty.view().empty()) << "Empty file view not empty";
+
+    MappedFile missing("no-such-file.txt");
+    EXPECT_FALSE(missing.isOpen()) << "Missing file open";
+}
+
+TEST(PuzzleScannerTest, MatchesReader){
+    MappedFile mapped("sudoku-test-lines.txt");
+    ASSERT_TRUE(mapped.isOpen()) << "Failed to map sudoku-test-lines.txt";
+    string_view data = mapped.view();
+    istringstream input{string(data)};
+
+    PuzzleScanner scanner(data);
+    PuzzleReader reader(input);
+    string_view record;
+    string puzzle;
+    while (scanner.next(record)){
+        ASSERT_TRUE(reader.next(puzzle)) << "Scanner found more puzzles than the reader";
+        EXPECT_TRUE(record.data() >= data.data() && record.data() + record.size() <= data.data() + data.size())
+            << "Record " << scanner.getCount() << " not a view into the data";
+
+        //Both should load the same board, givens and blanks included
+        Sudoku scanned, read;
+        EXPECT_EQ(scanned.load(record), read.load(puzzle)) << "Logical differs on puzzle " << scanner.getCount();
+        EXPECT_EQ(scanned.getBoard().cells, read.getBoard().cells) << "Board differs on puzzle " << scanner.getCount();
+        EXPECT_EQ(scanned.getGrid().size(), grid_size) << "Record not a whole puzzle";
+    }
+    EXPECT_FALSE(reader.next(puzzle)) << "Reader found more puzzles than the scanner";
+    EXPECT_EQ(scanner.getCount(), 5) << "Scanner count not 5";
+}
+
+TEST(PuzzleScannerTest, BrokenGrids){
+    //Rows that don't add up to a grid are dropped, a line puzzle in the middle still counts
+    string text = "1 2 3 4 5 6 7 8 9\n" + string(grid_size, '.') + "\n12\n";
+    for (int r = 0; r < number_of_element_values; ++r){
+        text += "- - - - - - - - -\r\n";
+        if (r == 4){
+            text += "~~~~~~~~~~~~~~~~~\n";
+        }
+    }
+    PuzzleScanner scanner(text);
+    string_view record;
+    ASSERT_TRUE(scanner.next(record)) << "Line puzzle not found";
+    EXPECT_EQ(record, string(grid_size, '.')) << "Line puzzle record wrong";
+    ASSERT_TRUE(scanner.next(record)) << "Grid after a broken row not found";
+    EXPECT_EQ(record.substr(0, 5), "- - -") << "Grid record does not start at its first row";
+    Sudoku s1;
+    EXPECT_TRUE(s1.load(record)) << "Blank grid record not logical";
+    EXPECT_FALSE(scanner.next(record)) << "Scanner returned a third puzzle";
+}
+
+TEST(PuzzleScannerTest, SolveBatch){
+    MappedFile mapped("sudoku-test-lines.txt");
+    ASSERT_TRUE(mapped.isOpen()) << "Failed to map sudoku-test-lines.txt";
+    ifstream input;
+    input.open("sudoku-test-lines.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-lines.txt";
+
+    vector<string> streamed, scanned;
+    auto collect = [] (vector<string>& lines){
+        return [&lines] (size_t i, const Sudoku& s, bool solved){
+            lines.emplace_back();
+            s.appendLine(lines.back());
+        };
+    };
+    BatchResult streamResult = solveBatch(input, HYBRID, collect(streamed));
+    BatchResult scanResult = solveBatch(mapped.view(), HYBRID, collect(scanned));
+    EXPECT_EQ(scanResult.solved, streamResult.solved) << "Solved count differs from stream batch";
+    EXPECT_EQ(scanResult.failed, streamResult.failed) << "Failed count differs from stream batch";
+    EXPECT_EQ(scanned, streamed) << "Solutions differ from stream batch";
+
+    vector<string> parallel;
+    BatchResult parallelResult = solveBatchParallel(mapped.view(), HYBRID, 4, [&parallel] (size_t i, string_view line, bool solved){
+        parallel.emplace_back(line);
+    });
+    EXPECT_EQ(parallelResult.total(), 5) << "Parallel total not 5";
+    EXPECT_EQ(parallel, streamed) << "Parallel solutions differ from stream batch";
+}
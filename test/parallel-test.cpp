@@ -0,0 +1,41 @@
+#include "gtest/gtest.h"
+#include "sudoku/parallel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace sudoku;
+
+TEST(ParallelForTest, EveryItemOnce){
+    const size_t count = 1000;
+    vector<atomic<int>> seen(count);
+    vector<atomic<int>> byWorker(4);
+    parallelFor(count, 4, [&](unsigned int worker, size_t i){
+        ++seen[i];
+        ++byWorker[worker];
+        //A few slow items at the front so the other workers have to steal
+        if (i < 4){
+            this_thread::sleep_for(chrono::milliseconds(20));
+        }
+    });
+    for (size_t i = 0; i < count; ++i){
+        EXPECT_EQ(seen[i], 1) << "Item " << i << " not run exactly once";
+    }
+    int total = 0;
+    for (auto& n : byWorker){
+        total += n;
+    }
+    EXPECT_EQ(total, count) << "Worker counts do not add up";
+}
+
+TEST(ParallelForTest, EdgeCases){
+    int runs = 0;
+    parallelFor(0, 8, [&](unsigned int, size_t){ ++runs; });
+    EXPECT_EQ(runs, 0) << "Task run with no items";
+    parallelFor(3, 0, [&](unsigned int worker, size_t){ EXPECT_EQ(worker, 0); ++runs; });
+    EXPECT_EQ(runs, 3) << "Zero workers did not fall back to the calling thread";
+    EXPECT_GE(defaultWorkers(), 1) << "Default workers less than 1";
+}
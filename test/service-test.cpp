@@ -0,0 +1,195 @@
+#include "gtest/gtest.h"
+#include "sudoku/batch.hpp"
+#include "sudoku/service.hpp"
+
+#include <atomic>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SUDOKU_TEST_SOCKETS 1
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace sudoku;
+
+//Every puzzle in sudoku-test-canonical.txt
+static vector<string> testPuzzles(){
+    ifstream input;
+    input.open("sudoku-test-canonical.txt");
+    PuzzleReader reader(input);
+    vector<string> puzzles;
+    string puzzle;
+    while (reader.next(puzzle)){
+        puzzles.push_back(puzzle);
+    }
+    return puzzles;
+}
+
+//Answer split at its spaces: status, grid, and stats
+static vector<string> fieldsOf(const string& answer){
+    istringstream in(answer);
+    vector<string> fields;
+    string field;
+    while (in >> field){
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+TEST(ServiceTest, AnswerRequest){
+    vector<string> puzzles = testPuzzles();
+    ASSERT_EQ(puzzles.size(), 9) << "Failed to read sudoku-test-canonical.txt";
+    ServiceConfig config;
+    Sudoku sudoku;
+    Sudoku expected;
+    expected.setSolverType(DLX);
+    ASSERT_TRUE(expected.load(puzzles[3]) && expected.solve()) << "Failed to solve a test puzzle";
+    string solution;
+    expected.appendLine(solution);
+
+    for (const char* options : {"", "backtrack ", "hybrid ", "dlx ", "  ms=0  nodes=0 "}){
+        vector<string> fields = fieldsOf(answerRequest(options + puzzles[3] + "\r", sudoku, config));
+        ASSERT_EQ(fields.size(), 4) << "Answer not status, grid, and two stats with options " << options;
+        EXPECT_EQ(fields[0], "solved") << "Status not solved with options " << options;
+        EXPECT_EQ(fields[1], solution) << "Wrong solution with options " << options;
+        EXPECT_EQ(fields[2].rfind("nodes=", 0), 0) << "Node count missing with options " << options;
+        EXPECT_EQ(fields[3].rfind("us=", 0), 0) << "Time missing with options " << options;
+    }
+
+    //Hard puzzles need more than rules and more than one node
+    vector<string> fields = fieldsOf(answerRequest("rules " + puzzles[3], sudoku, config));
+    EXPECT_EQ(fields[0], "stuck") << "Rules on a hard puzzle not stuck";
+    EXPECT_EQ(fields[1], puzzles[3]) << "Unsolved answer not the puzzle as given";
+    EXPECT_EQ(fieldsOf(answerRequest("backtrack nodes=1 " + puzzles[3], sudoku, config))[0], "node_limit")
+        << "Node limit not hit";
+    atomic<bool> cancel{true};
+    EXPECT_EQ(fieldsOf(answerRequest(puzzles[3], sudoku, config, &cancel))[0], "cancelled") << "Cancel not passed on";
+
+    string broken = "11" + string(grid_size - 2, '-');
+    EXPECT_EQ(fieldsOf(answerRequest(broken, sudoku, config))[0], "invalid") << "Puzzle breaking a rule not invalid";
+
+    EXPECT_EQ(answerRequest("", sudoku, config), "error empty request") << "Empty request not an error";
+    EXPECT_EQ(answerRequest("fast " + puzzles[3], sudoku, config), "error unknown option fast") << "Unknown option not an error";
+    EXPECT_EQ(answerRequest("ms=x " + puzzles[3], sudoku, config), "error unknown option ms=x") << "Bad number not an error";
+    EXPECT_EQ(fieldsOf(answerRequest(puzzles[3].substr(1), sudoku, config))[0], "error") << "Short puzzle not an error";
+    EXPECT_EQ(fieldsOf(answerRequest(puzzles[3] + " dlx", sudoku, config))[0], "error") << "Option after the puzzle not an error";
+}
+
+TEST(ServiceTest, Pool){
+    atomic<int> ran{0};
+    {
+        SolverPool pool(3);
+        EXPECT_EQ(pool.getWorkers(), 3) << "Pool worker count not 3";
+        for (int i = 0; i < 100; ++i){
+            pool.submit([&ran] (Sudoku& sudoku){
+                sudoku.load(string(grid_size, '-'));
+                ++ran;
+            });
+        }
+    }
+    EXPECT_EQ(ran, 100) << "Pool did not run every task before stopping";
+}
+
+#if defined(SUDOKU_TEST_SOCKETS)
+//Sends every request in one write, then reads until every answer is back
+static vector<string> sendRequests(const int& fd, const vector<string>& requests){
+    string out;
+    for (const string& request : requests){
+        out.append(request).push_back('\n');
+    }
+    EXPECT_EQ(send(fd, out.data(), out.size(), 0), ssize_t(out.size())) << "Failed to send requests";
+    vector<string> answers;
+    string in;
+    char chunk[4096];
+    while (answers.size() < requests.size()){
+        ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        if (received <= 0){
+            break;
+        }
+        in.append(chunk, received);
+        for (size_t end; (end = in.find('\n')) != string::npos; in.erase(0, end + 1)){
+            answers.push_back(in.substr(0, end));
+        }
+    }
+    return answers;
+}
+#endif
+
+TEST(ServiceTest, Socket){
+#if !defined(SUDOKU_TEST_SOCKETS)
+    GTEST_SKIP() << "No POSIX sockets";
+#else
+    vector<string> puzzles = testPuzzles();
+    ASSERT_EQ(puzzles.size(), 9) << "Failed to read sudoku-test-canonical.txt";
+    //Every puzzle with every method, so answers finish out of order on the workers
+    vector<string> requests, solutions;
+    Sudoku expected;
+    expected.setSolverType(DLX);
+    for (int round = 0; round < 4; ++round){
+        for (const string& puzzle : puzzles){
+            const char* methods[] = {"backtrack ", "hybrid ", "dlx ", ""};
+            requests.push_back(methods[round] + puzzle);
+            expected.load(puzzle);
+            expected.solve();
+            solutions.emplace_back();
+            expected.appendLine(solutions.back());
+        }
+    }
+
+    ServiceConfig config;
+    config.workers = 4;
+    config.maxPipelined = 8;
+    SolverService service(config);
+    const string path = "sudoku-test-service.sock";
+    ASSERT_TRUE(service.start(path)) << "Service did not start on a Unix socket";
+    EXPECT_FALSE(service.start(path)) << "Service started twice";
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path.c_str());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0) << "Failed to connect to the Unix socket";
+    vector<string> answers = sendRequests(fd, requests);
+    ASSERT_EQ(answers.size(), requests.size()) << "Not every pipelined request was answered";
+    for (size_t i = 0; i < answers.size(); ++i){
+        vector<string> fields = fieldsOf(answers[i]);
+        ASSERT_EQ(fields.size(), 4) << "Answer " << i << " not status, grid, and two stats";
+        EXPECT_EQ(fields[0], "solved") << "Request " << i << " not solved";
+        EXPECT_EQ(fields[1], solutions[i]) << "Answer " << i << " out of order or wrong";
+    }
+    //The same connection keeps working
+    answers = sendRequests(fd, {"nonsense"});
+    ASSERT_EQ(answers.size(), 1) << "Second batch not answered";
+    EXPECT_EQ(fieldsOf(answers[0])[0], "error") << "Nonsense request not an error";
+    close(fd);
+    EXPECT_EQ(service.getAnswered(), requests.size() + 1) << "Answered count wrong";
+
+    service.stop();
+    EXPECT_NE(access(path.c_str(), F_OK), 0) << "Socket file left after stopping";
+
+    //Localhost TCP on a free port, answered by a service started again
+    ASSERT_TRUE(service.start("tcp:0")) << "Service did not start on TCP";
+    ASSERT_NE(service.getPort(), 0) << "No port picked";
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(service.getPort());
+    local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)), 0) << "Failed to connect over TCP";
+    answers = sendRequests(fd, {puzzles[0], puzzles[1]});
+    ASSERT_EQ(answers.size(), 2) << "TCP requests not answered";
+    EXPECT_EQ(fieldsOf(answers[1])[1], solutions[1]) << "TCP answer wrong";
+    //Stopping with a client still connected closes it
+    service.stop();
+    char byte;
+    EXPECT_EQ(recv(fd, &byte, 1, 0), 0) << "Connection not closed by stop";
+    close(fd);
+
+    EXPECT_FALSE(service.start("tcp:99999")) << "Port out of range accepted";
+#endif
+}
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+#include "sudoku/simd.hpp"
+
+using namespace std;
+using namespace sudoku;
+
+//Used masks rebuilt from the filled squares of a board
+static void usedMasks(const Board& board, UsedMasks& rowUsed, UsedMasks& colUsed, UsedMasks& boxUsed){
+    rowUsed.fill(0);
+    colUsed.fill(0);
+    boxUsed.fill(0);
+    for (uint8_t i = 0; i < grid_size; i++){
+        if (!board[i].isBlank()){
+            rowUsed[rowOf(i)] |= Candidates::bit(board[i].getElement());
+            colUsed[colOf(i)] |= Candidates::bit(board[i].getElement());
+            boxUsed[boxOf(i)] |= Candidates::bit(board[i].getElement());
+        }
+    }
+}
+
+TEST(SimdTest, MatchesScalar){
+    ifstream input;
+    input.open("sudoku-test-lines.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-lines.txt";
+    string line;
+    int boards = 0;
+    while (getline(input, line)){
+        Sudoku s1;
+        s1.load(line);
+        Board board = s1.getBoard();
+        UsedMasks rowUsed, colUsed, boxUsed;
+        usedMasks(board, rowUsed, colUsed, boxUsed);
+
+        //Thin out the possibles so some squares end up with none or one left
+        for (int k = 0; k < 4; k++){
+            Board kernel = board, scalar = board;
+            recomputePossibles(kernel, rowUsed, colUsed, boxUsed);
+            recomputePossiblesScalar(scalar, rowUsed, colUsed, boxUsed);
+            for (int i = 0; i < grid_size; i++){
+                EXPECT_EQ(kernel.possibles[i], scalar.possibles[i]) << "Recomputed possibles differ at " << i;
+                scalar.possibles[i] &= (i*7 + k*13) % 3 == 0 ? 0x1ff >> k : 0x1ff;
+            }
+
+            SinglesScan fast = scanSingles(scalar, rowUsed, colUsed, boxUsed);
+            SinglesScan slow = scanSinglesScalar(scalar, rowUsed, colUsed, boxUsed);
+            EXPECT_EQ(fast.naked, slow.naked) << "Naked singles differ on line " << boards << " pass " << k;
+            EXPECT_EQ(fast.hidden, slow.hidden) << "Hidden singles differ on line " << boards << " pass " << k;
+            EXPECT_EQ(fast.contradiction, slow.contradiction) << "Contradiction differs on line " << boards << " pass " << k;
+        }
+        boards++;
+    }
+    EXPECT_GT(boards, 0) << "No boards read";
+}
+
+TEST(SimdTest, FindsSingles){
+    //Only square 0 is blank, so 1 is a naked single and hidden in its row, column, and box
+    string puzzle = "-23456789456789123789123456234567891567891234891234567345678912678912345912345678";
+    Sudoku s1;
+    ASSERT_TRUE(s1.load(puzzle)) << "Nearly full grid not logical";
+    //Loading fills the single in, so blank it again
+    Board board = s1.getBoard();
+    board.cells[0] = blank_element_value;
+    board.possibles[0] = Candidates::bit(1);
+    UsedMasks rowUsed, colUsed, boxUsed;
+    usedMasks(board, rowUsed, colUsed, boxUsed);
+
+    SinglesScan scan = scanSingles(board, rowUsed, colUsed, boxUsed);
+    EXPECT_FALSE(scan.contradiction) << "Contradiction on a solvable grid";
+    EXPECT_EQ(scan.naked[0], 1) << "Naked single at square 0 not found";
+    EXPECT_EQ(scan.hidden[0], Candidates::bit(1)) << "Hidden single not found in row 0";
+    EXPECT_EQ(scan.hidden[number_of_element_values], Candidates::bit(1)) << "Hidden single not found in column 0";
+    EXPECT_EQ(scan.hidden[2*number_of_element_values], Candidates::bit(1)) << "Hidden single not found in box 0";
+
+    board.possibles[0] = 0;
+    EXPECT_TRUE(scanSingles(board, rowUsed, colUsed, boxUsed).contradiction) << "Blank square with no possibles not a contradiction";
+}
@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 #include "sudoku/sudoku.hpp"
 
+#include <unordered_set>
+
 using namespace std;
 using namespace sudoku;
 
@@ -56,7 +58,7 @@ TEST_F(SquareTest, SettersAndGetters) {
 
 TEST_F(SquareTest, PossiblesTests) {
 
-    std::unordered_set<uint8_t> possibles_compare = {2, 3, 7};
+    Candidates possibles_compare = {2, 3, 7};
 
     //Check possibles
     EXPECT_EQ(s3.getPossibles(), possibles_compare) << "Possibles set to {2, 3, 7} failed";
@@ -76,6 +78,25 @@ TEST_F(SquareTest, PossiblesTests) {
     EXPECT_EQ(s3.getPossibles().size(), 0) << "RemoveAllPossibles does not remove all possibles";
 }
 
+TEST(CandidatesTest, MaskIteration) {
+    Candidates c = {9, 1, 5};
+    EXPECT_EQ(c.size(), 3) << "Candidates size not 3";
+    EXPECT_EQ(c.mask(), 0b100010001) << "Candidates mask not set for 1, 5 and 9";
+    EXPECT_FALSE(c.insert(5)) << "Insert of existing candidate succeeded";
+    EXPECT_FALSE(c.insert(0)) << "Insert of invalid candidate 0 succeeded";
+    EXPECT_FALSE(c.insert(number_of_element_values+1)) << "Insert of out of range candidate succeeded";
+
+    std::vector<uint8_t> vals(c.begin(), c.end());
+    EXPECT_EQ(vals, std::vector<uint8_t>({1, 5, 9})) << "Candidates not iterated in ascending order";
+
+    c.erase(5);
+    EXPECT_FALSE(c.contains(5)) << "Erased candidate still present";
+    EXPECT_EQ(Candidates::fromMask(c.mask()), c) << "fromMask does not round trip";
+    c.clear();
+    EXPECT_TRUE(c.empty()) << "Candidates not empty after clear";
+    EXPECT_EQ(c.begin(), c.end()) << "Empty candidates begin not equal to end";
+}
+
 //Sudoku class tests
 
 TEST(SudokuInputTest, emptyFile){
@@ -179,12 +200,12 @@ class SudokuTestValidInput : public ::testing::Test {
 };
 
 TEST_F(SudokuTestValidInput, EachInFuncs){
-    auto false_func = [](uint8_t i, std::vector<Square> &grid){ return false; };
+    auto false_func = [](uint8_t i, Board &grid){ return false; };
     EXPECT_FALSE(s1.eachInRow(4, false_func)) << "EachInRow not false for false function";
     EXPECT_FALSE(s1.eachInCol(4, false_func)) << "EachInCol not false for false function";
     EXPECT_FALSE(s1.eachInBox(4, false_func)) << "EachInBox not false for false function";
 
-    auto true_func = [](uint8_t i, std::vector<Square> &grid){ return true; };
+    auto true_func = [](uint8_t i, Board &grid){ return true; };
     EXPECT_TRUE(s1.eachInRow(4, true_func)) << "EachInRow not true for true function";
     EXPECT_TRUE(s1.eachInCol(4, true_func)) << "EachInCol not true for true function";
     EXPECT_TRUE(s1.eachInBox(4, true_func)) << "EachInBox not true for true function";
@@ -198,15 +219,36 @@ TEST_F(SudokuTestValidInput, EachInFuncs){
     auto curCol = col.begin();
     auto curBox = box.begin();
     
-    auto row_func = [&curRow](uint8_t i, std::vector<Square> &grid){ return *curRow++ == grid[i].getElement(); };
+    auto row_func = [&curRow](uint8_t i, Board &grid){ return *curRow++ == grid[i].getElement(); };
     EXPECT_TRUE(s1.eachInRow(31, row_func)) << "EachInRow not true for row function";
-    auto col_func = [&curCol](uint8_t i, std::vector<Square> &grid){ return *curCol++ == grid[i].getElement(); };
+    auto col_func = [&curCol](uint8_t i, Board &grid){ return *curCol++ == grid[i].getElement(); };
     EXPECT_TRUE(s1.eachInCol(31, col_func)) << "EachInCol not true for col function";
-    auto box_func = [&curBox](uint8_t i, std::vector<Square> &grid){ return *curBox++ == grid[i].getElement(); };
+    auto box_func = [&curBox](uint8_t i, Board &grid){ return *curBox++ == grid[i].getElement(); };
     EXPECT_TRUE(s1.eachInBox(31, box_func)) << "EachInBox not true for box function";
   
 }
 
+TEST(PeerTablesTest, Peers){
+    for (int index = 0; index < grid_size; ++index){
+        std::unordered_set<uint8_t> peers(peer_tables.all[index].begin(), peer_tables.all[index].end());
+        EXPECT_EQ(peers.size(), peer_count) << "Peers of " << index << " are not distinct";
+        EXPECT_EQ(peers.count(index), 0) << "Peers of " << index << " contain itself";
+        for (uint8_t peer : peers){
+            EXPECT_TRUE(rowOf(peer) == rowOf(index) || colOf(peer) == colOf(index) || boxOf(peer) == boxOf(index))
+                << peer << " is not related to " << index;
+        }
+    }
+}
+
+TEST_F(SudokuTestValidInput, VisitPeers){
+    int count = 0;
+    EXPECT_TRUE(s1.visitPeers(31, [&count](uint8_t i, Board &grid){ ++count; return true; }));
+    EXPECT_EQ(count, peer_count) << "visitPeers did not visit every related square once";
+    count = 0;
+    EXPECT_FALSE(s1.visitBox(31, [&count](uint8_t i, Board &grid){ return ++count < 3; }));
+    EXPECT_EQ(count, 3) << "visitBox did not stop on first false";
+}
+
 TEST_F(SudokuTestValidInput, CheckSquare){
 
     EXPECT_FALSE(s1.checkSquare(grid_size)) << "Check square with too large index did not return false";
@@ -235,6 +277,8 @@ TEST_F(SudokuTestValidInput, AssignSquare){
     EXPECT_EQ(s1.getGrid()[5].getElement(), 5) << "Failed assignSquare to given value changed value";
 
     EXPECT_TRUE(s1.assignSquare(4, 1)) << "Assign square with no conflictions did not return true";
+    EXPECT_FALSE(s1.checkSquare(1, 1)) << "Check square in same row does not see assigned value";
+    EXPECT_FALSE(s1.checkSquare(22, 1)) << "Check square in same box does not see assigned value";
 
     
     s2.setSolverType(BACKTRACK);
@@ -242,7 +286,7 @@ TEST_F(SudokuTestValidInput, AssignSquare){
     //Get current number of possibles from related squares
     vector<uint8_t> backtrackPossiblesRelated;
 
-    auto getPossiblesBacktrack = [&backtrackPossiblesRelated](uint8_t i, std::vector<Square> &grid){
+    auto getPossiblesBacktrack = [&backtrackPossiblesRelated](uint8_t i, Board &grid){
         backtrackPossiblesRelated.push_back(grid[i].getPossibles().size()); return true;
     };
 
@@ -256,7 +300,7 @@ TEST_F(SudokuTestValidInput, AssignSquare){
 
     auto curpossible = backtrackPossiblesRelated.begin();
 
-    auto comparePossiblesBacktrack = [&curpossible](uint8_t i, std::vector<Square> &grid){
+    auto comparePossiblesBacktrack = [&curpossible](uint8_t i, Board &grid){
         EXPECT_EQ(*curpossible++, grid[i].getPossibles().size()) << "Possibles not equal for backtrack"; return true;
     };
 
@@ -282,6 +326,527 @@ TEST_F(SudokuTestValidInput, Solve){
     EXPECT_FALSE(s2.solve()) << "Solve not FALSE on empty board";
 }
 
+TEST_F(SudokuTestValidInput, SolveRules){
+    ifstream solution;
+    solution.open("sudoku-test1-solved.txt");
+    ASSERT_TRUE(solution.is_open()) << "Failed to open sudoku-test1-solved.txt";
+    Sudoku solved(solution);
+
+    s1.setSolverType(RULES);
+    EXPECT_TRUE(s1.solve()) << "Rules solve not TRUE on beginner puzzle";
+    for (int i = 0; i < grid_size; i++){
+        EXPECT_EQ(s1.getGrid()[i].getElement(), solved.getGrid()[i].getElement()) << "Rules solve not correct";
+    }
+
+    //Needs guessing, rules should stop with the grid still blank in places but not wrong
+    ifstream hard;
+    hard.open("sudoku-test-too-large.txt");
+    ASSERT_TRUE(hard.is_open()) << "Failed to open sudoku-test-too-large.txt";
+    Sudoku s2(hard, RULES);
+    EXPECT_FALSE(s2.solve()) << "Rules solve not FALSE on puzzle that needs guessing";
+    for (uint8_t i = 0; i < grid_size; i++){
+        EXPECT_TRUE(s2.getGrid()[i].isBlank() || s2.checkSquare(i)) << "Rules solve placed invalid value at " << i;
+    }
+}
+
+//Each puzzle needs its rule on top of singles, and none of the other eliminating rules except where noted
+TEST(SudokuRulesTest, EliminatingRules){
+    struct RulePuzzle {
+        string puzzle;
+        SolveRule rule;
+        Difficulty grade;
+    };
+    const vector<RulePuzzle> puzzles = {
+        {"--------32-4--8--------78--6--4---7--9----5----76---8--3--2--5--4-3-----751-496--", INTERSECTION, MEDIUM},
+        {"---164----7-------45----6---1-3--46-6---8-52-7-------3-3--5---19----73----4-2-9--", NAKED_PAIR, HARD},
+        {"-------9819-----466---9-23-8-4--2-------6--5----9--3---------7-5---1--6-93--57482", HIDDEN_PAIR, HARD},
+        //Needs intersections as well
+        {"4--1-----5-----7---8--3----71---263---39--8-1------------76-1---6-45--78-4--2---6", HIDDEN_TRIPLE, HARD}
+    };
+    for (const RulePuzzle& test : puzzles){
+        Sudoku expected;
+        expected.setSolverType(DLX);
+        ASSERT_TRUE(expected.load(test.puzzle) && expected.solve()) << "Failed to solve rule " << test.rule << " puzzle";
+
+        Sudoku s1;
+        ASSERT_TRUE(s1.load(test.puzzle)) << "Rule " << test.rule << " puzzle not logical";
+        EXPECT_EQ(s1.grade(), test.grade) << "Rule " << test.rule << " puzzle graded wrong";
+        s1.setSolverType(RULES);
+        ASSERT_TRUE(s1.solve()) << "Rules solve not TRUE on rule " << test.rule << " puzzle";
+        EXPECT_EQ(s1.getBoard().cells, expected.getBoard().cells) << "Rules solve not correct on rule " << test.rule << " puzzle";
+
+        if constexpr (solve_stats_enabled){
+            const SolveStats& stats = s1.getStats();
+            EXPECT_GT(stats.deductions[test.rule], 0) << "Rule " << test.rule << " never applied";
+            for (int rule = NAKED_PAIR; rule < RULE_COUNT; ++rule){
+                if (rule != test.rule && !(test.rule == HIDDEN_TRIPLE && rule == INTERSECTION)){
+                    EXPECT_EQ(stats.deductions[rule], 0) << "Rule " << rule << " applied on rule " << test.rule << " puzzle";
+                }
+            }
+        }
+    }
+}
+
+TEST(SudokuHybridTest, Solve){
+    ifstream input;
+    input.open("sudoku-test-too-large.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-too-large.txt";
+    Sudoku hybrid(input, HYBRID);
+    input.clear();
+    input.seekg(0);
+    Sudoku backtrack(input, BACKTRACK);
+
+    EXPECT_TRUE(hybrid.solve()) << "Hybrid solve not TRUE";
+    EXPECT_TRUE(backtrack.solve()) << "Backtrack solve not TRUE";
+    for (uint8_t i = 0; i < grid_size; i++){
+        EXPECT_EQ(hybrid.getGrid()[i].getElement(), backtrack.getGrid()[i].getElement()) << "Hybrid solve not correct at " << i;
+    }
+    EXPECT_LT(hybrid.getSteps(), backtrack.getSteps()) << "Hybrid solve did not visit fewer nodes than backtracking";
+
+    ifstream blank;
+    blank.open("sudoku-test-blank.txt");
+    ASSERT_TRUE(blank.is_open()) << "Failed to open sudoku-test-blank.txt";
+    Sudoku s2(blank, HYBRID);
+    EXPECT_TRUE(s2.solve()) << "Hybrid solve not TRUE on blank board";
+    for (uint8_t i = 0; i < grid_size; i++){
+        EXPECT_TRUE(s2.checkSquare(i)) << "Hybrid solve placed invalid value at " << i;
+    }
+}
+
+TEST(SudokuSearchTest, PauseAndResume){
+    ifstream input;
+    input.open("sudoku-test-too-large.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-too-large.txt";
+    Sudoku whole(input, BACKTRACK);
+    input.clear();
+    input.seekg(0);
+    Sudoku sliced(input, BACKTRACK);
+    ASSERT_TRUE(whole.solve()) << "Backtrack solve not TRUE";
+    ASSERT_GT(whole.getSteps(), 100) << "Puzzle too easy to pause";
+
+    //A small budget at a time, the search has to carry on where it stopped to get the same answer
+    SolveStatus status = sliced.solveFor(7);
+    unsigned int slices = 1;
+    while (status == PAUSED){
+        EXPECT_TRUE(sliced.isPaused()) << "Paused search not marked paused";
+        status = sliced.resume(7);
+        ++slices;
+    }
+    EXPECT_EQ(status, SOLVED) << "Sliced search not SOLVED";
+    EXPECT_FALSE(sliced.isPaused()) << "Finished search still paused";
+    EXPECT_EQ(sliced.getSteps(), whole.getSteps()) << "Sliced search visited different nodes";
+    EXPECT_EQ(slices, (whole.getSteps() + 6) / 7) << "Budget not used in full before pausing";
+    EXPECT_EQ(sliced.getBoard().cells, whole.getBoard().cells) << "Sliced search found a different solution";
+    if constexpr (solve_stats_enabled){
+        EXPECT_EQ(sliced.getStats().backtracks, whole.getStats().backtracks) << "Sliced search backtracked differently";
+    }
+    EXPECT_EQ(sliced.resume(7), NO_SOLUTION) << "Finished search resumed";
+
+    //No budget runs to the end
+    input.clear();
+    input.seekg(0);
+    Sudoku s1(input, BACKTRACK);
+    EXPECT_EQ(s1.solveFor(0), SOLVED) << "Unlimited search not SOLVED";
+    EXPECT_EQ(s1.getSteps(), whole.getSteps()) << "Unlimited search visited different nodes";
+
+    //Breaks no rule as given, but has no solution
+    ASSERT_TRUE(s1.load("53-1---2--6--9-4-51-9-587-------3--7--86-----2---7-8--4--73-1-8-----4--------13--"))
+        << "Puzzle with no solution not logical";
+    EXPECT_EQ(s1.solveFor(0), NO_SOLUTION) << "Puzzle with no solution not NO_SOLUTION";
+    if constexpr (solve_stats_enabled){
+        EXPECT_EQ(s1.getStats().backtracks, s1.getSteps() - 1) << "Every node but the root should be undone";
+    }
+
+    //Loading drops a paused search
+    s1.load(string(grid_size, '-'));
+    EXPECT_EQ(s1.solveFor(1), PAUSED) << "Search with one node not PAUSED";
+    s1.load(string(grid_size, '-'));
+    EXPECT_FALSE(s1.isPaused()) << "Load did not drop the paused search";
+    EXPECT_EQ(s1.resume(1), NO_SOLUTION) << "Resumed a dropped search";
+}
+
+TEST(SudokuSearchTest, DropPaused){
+    ifstream input;
+    input.open("sudoku-test-too-large.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-too-large.txt";
+    Sudoku fresh(input, BACKTRACK);
+    const Board givens = fresh.getBoard();
+    Difficulty grade = fresh.grade();
+    EXPECT_EQ(fresh.countSolutions(2), 1) << "Fresh puzzle not one solution";
+    ASSERT_TRUE(fresh.solve()) << "Fresh puzzle not solved";
+    const Board solution = fresh.getBoard();
+    uint8_t blank = 0;
+    while (!givens[blank].isBlank()){
+        ++blank;
+    }
+    uint8_t val = solution[blank].getElement();
+
+    //Every call that drops a paused search has to start from the givens again, not from its guesses
+    for (uint64_t budget : {5, 50, 500}){
+        for (SolveMethod method : {BACKTRACK, HYBRID, DLX}){
+            Sudoku s1;
+            s1.load(givens);
+            ASSERT_EQ(s1.solveFor(budget), PAUSED) << "Search with budget " << budget << " not PAUSED";
+            s1.setSolverType(method);
+            EXPECT_TRUE(s1.solve()) << "Solve after pausing at " << budget << " not TRUE with method " << method;
+            EXPECT_EQ(s1.getBoard().cells, solution.cells) << "Solve after pausing at " << budget << " wrong with method " << method;
+        }
+
+        Sudoku s2;
+        s2.load(givens);
+        s2.solveFor(budget);
+        EXPECT_EQ(s2.countSolutions(2), 1) << "Solutions after pausing at " << budget << " not one";
+        EXPECT_EQ(s2.getBoard().cells, givens.cells) << "Counting after pausing at " << budget << " left guesses";
+        EXPECT_FALSE(s2.isPaused()) << "Counting did not drop the paused search";
+
+        s2.solveFor(budget);
+        EXPECT_TRUE(s2.isSolvable()) << "Not solvable after pausing at " << budget;
+        s2.solveFor(budget);
+        EXPECT_EQ(s2.grade(), grade) << "Grade after pausing at " << budget << " differs";
+        EXPECT_TRUE(s2.isPaused()) << "Grading dropped the paused search";
+
+        ASSERT_TRUE(s2.place(blank, val)) << "Place after pausing at " << budget << " failed";
+        ASSERT_TRUE(s2.undo()) << "Undo after pausing at " << budget << " failed";
+        EXPECT_EQ(s2.getBoard().cells, givens.cells) << "Place and undo after pausing at " << budget << " left guesses";
+
+        s2.solveFor(budget);
+        s2.setSolverType(HYBRID);
+        EXPECT_TRUE(s2.solveParallel(2)) << "Parallel solve after pausing at " << budget << " not TRUE";
+        EXPECT_EQ(s2.getBoard().cells, solution.cells) << "Parallel solve after pausing at " << budget << " wrong";
+    }
+}
+
+TEST(SudokuLimitsTest, Limits){
+    const string hard = "-----4597-9---6-----7--5---7--4---5---3-2--14-4---97-365---3--1--8---3---1-9-----";
+    for (SolveMethod method : {BACKTRACK, HYBRID, DLX}){
+        Sudoku whole;
+        whole.setSolverType(method);
+        ASSERT_TRUE(whole.load(hard)) << "Hard puzzle not logical";
+        ASSERT_TRUE(whole.solve()) << "Hard puzzle not solved with method " << method;
+
+        Sudoku s1;
+        s1.setSolverType(method);
+        s1.load(hard);
+        Board before = s1.getBoard();
+        SolveLimits limits;
+        limits.maxNodes = 5;
+        EXPECT_EQ(s1.solve(limits), NODE_LIMIT) << "Node limit not hit with method " << method;
+        EXPECT_EQ(s1.getSteps(), 5) << "Node limit did not stop after 5 nodes with method " << method;
+        EXPECT_EQ(s1.getBoard().cells, before.cells) << "Stopped solve changed the grid with method " << method;
+
+        //Limits only last for the one solve
+        EXPECT_TRUE(s1.solve()) << "Solve after a stopped one not TRUE with method " << method;
+        EXPECT_EQ(s1.getBoard().cells, whole.getBoard().cells) << "Solve after a stopped one differs with method " << method;
+
+        s1.load(hard);
+        EXPECT_EQ(s1.solve(chrono::steady_clock::now()), TIMED_OUT) << "Passed deadline not TIMED_OUT with method " << method;
+        EXPECT_EQ(s1.getSteps(), 0) << "Passed deadline visited nodes with method " << method;
+
+        s1.load(hard);
+        atomic<bool> cancel{true};
+        limits = SolveLimits();
+        limits.cancel = &cancel;
+        EXPECT_EQ(s1.solve(limits), CANCELLED) << "Set cancel flag not CANCELLED with method " << method;
+
+        //Limits that are never hit change nothing
+        s1.load(hard);
+        cancel = false;
+        limits.maxNodes = whole.getSteps();
+        limits.deadline = chrono::steady_clock::now() + chrono::hours(1);
+        EXPECT_EQ(s1.solve(limits), SOLVED) << "Solve within limits not SOLVED with method " << method;
+        EXPECT_EQ(s1.getSteps(), whole.getSteps()) << "Limits changed the search with method " << method;
+
+        s1.load("53-1---2--6--9-4-51-9-587-------3--7--86-----2---7-8--4--73-1-8-----4--------13--");
+        EXPECT_EQ(s1.solve(limits), NO_SOLUTION) << "Puzzle with no solution not NO_SOLUTION with method " << method;
+    }
+
+    //Rules never search, so there is nothing to stop
+    ifstream easy;
+    easy.open("sudoku-test1.txt");
+    ASSERT_TRUE(easy.is_open()) << "Failed to open sudoku-test1.txt";
+    Sudoku rules(easy, RULES);
+    SolveLimits limits;
+    limits.maxNodes = 1;
+    EXPECT_EQ(rules.solve(limits), SOLVED) << "Rules solve stopped by a node limit";
+}
+
+TEST(SudokuParallelTest, SolveParallel){
+    for (unsigned int threads : {1u, 4u}){
+        ifstream input;
+        input.open("sudoku-test-too-large.txt");
+        ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-too-large.txt";
+        Sudoku parallel(input);
+        input.clear();
+        input.seekg(0);
+        Sudoku hybrid(input, HYBRID);
+
+        EXPECT_TRUE(parallel.solveParallel(threads)) << "Parallel solve not TRUE with " << threads << " threads";
+        EXPECT_TRUE(hybrid.solve());
+        for (uint8_t i = 0; i < grid_size; i++){
+            EXPECT_EQ(parallel.getGrid()[i].getElement(), hybrid.getGrid()[i].getElement()) << "Parallel solve not correct at " << i;
+        }
+        EXPECT_GT(parallel.getSteps(), 0) << "Parallel solve did not count steps";
+    }
+
+    //Many solutions, any one of them will do
+    ifstream blank;
+    blank.open("sudoku-test-blank.txt");
+    ASSERT_TRUE(blank.is_open()) << "Failed to open sudoku-test-blank.txt";
+    Sudoku s2(blank);
+    EXPECT_TRUE(s2.solveParallel(4)) << "Parallel solve not TRUE on blank board";
+    for (uint8_t i = 0; i < grid_size; i++){
+        EXPECT_FALSE(s2.getGrid()[i].isBlank()) << "Parallel solve left blank square at " << i;
+        EXPECT_TRUE(s2.checkSquare(i)) << "Parallel solve placed invalid value at " << i;
+    }
+
+    Sudoku s3;
+    EXPECT_FALSE(s3.solveParallel(4)) << "Parallel solve not FALSE on empty board";
+}
+
+TEST(SudokuCountTest, CountSolutions){
+    ifstream input;
+    input.open("sudoku-test1.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test1.txt";
+    Sudoku s1(input);
+    vector<Square> before = s1.getGrid();
+    EXPECT_EQ(s1.countSolutions(10), 1) << "Count not 1 for well formed puzzle";
+    EXPECT_TRUE(s1.hasUniqueSolution()) << "Well formed puzzle not unique";
+    for (uint8_t i = 0; i < grid_size; i++){
+        EXPECT_EQ(s1.getGrid()[i].getElement(), before[i].getElement()) << "Count changed the grid at " << i;
+        EXPECT_EQ(s1.getGrid()[i].getPossibles(), before[i].getPossibles()) << "Count changed possibles at " << i;
+    }
+    EXPECT_TRUE(s1.solve()) << "Solve failed after counting";
+
+    ifstream blank;
+    blank.open("sudoku-test-blank.txt");
+    ASSERT_TRUE(blank.is_open()) << "Failed to open sudoku-test-blank.txt";
+    Sudoku s2(blank);
+    EXPECT_EQ(s2.countSolutions(5), 5) << "Count did not stop at limit on blank board";
+    EXPECT_FALSE(s2.hasUniqueSolution()) << "Blank board unique";
+    EXPECT_EQ(s2.countSolutions(0), 0) << "Count with limit 0 not 0";
+
+    ifstream unsolvable;
+    unsolvable.open("sudoku-test-unsolvable.txt");
+    ASSERT_TRUE(unsolvable.is_open()) << "Failed to open sudoku-test-unsolvable.txt";
+    Sudoku s3(unsolvable);
+    EXPECT_TRUE(s3.isLogical()) << "Unsolvable puzzle rejected on read in";
+    EXPECT_EQ(s3.countSolutions(2), 0) << "Count not 0 for unsolvable puzzle";
+    EXPECT_FALSE(s3.hasUniqueSolution()) << "Unsolvable puzzle unique";
+
+    Sudoku s4;
+    EXPECT_EQ(s4.countSolutions(2), 0) << "Count not 0 for empty board";
+}
+
+TEST(SudokuMovesTest, PlaceAndUndo){
+    ifstream input;
+    input.open("sudoku-test1.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test1.txt";
+    Sudoku s1(input);
+    Board start = s1.getBoard();
+    Sudoku solved = s1;
+    solved.setSolverType(HYBRID);
+    ASSERT_TRUE(solved.solve()) << "Failed to solve sudoku-test1.txt";
+    Board solution = solved.getBoard();
+
+    int blank = 0;
+    while (!start[blank].isBlank()){
+        ++blank;
+    }
+    uint8_t right = solution[blank].getElement();
+    uint8_t wrong = 0;
+    for (uint8_t val : s1.candidates(blank)){
+        if (val != right){
+            wrong = val;
+        }
+    }
+    ASSERT_NE(wrong, 0) << "First blank square only has one possible";
+
+    EXPECT_FALSE(s1.place(0, 1)) << "Placed on a given square";
+    EXPECT_FALSE(s1.place(blank, 0)) << "Placed value 0";
+    EXPECT_EQ(s1.getMoveCount(), 0) << "Rejected moves recorded";
+
+    EXPECT_TRUE(s1.isSolvable()) << "Well formed puzzle not solvable";
+    ASSERT_TRUE(s1.place(blank, right)) << "Right value not placed";
+    EXPECT_EQ(s1.getBoard()[blank].getElement(), right) << "Placed value not on the board";
+    EXPECT_TRUE(s1.candidates(blank).empty()) << "Filled square still has possibles";
+    for (uint8_t peer : peer_tables.all[blank]){
+        EXPECT_FALSE(s1.candidates(peer).contains(right)) << "Placed value still possible at peer " << int(peer);
+    }
+    EXPECT_TRUE(s1.isSolvable()) << "Not solvable after the right move";
+    EXPECT_EQ(s1.getBoard().cells[blank], right) << "Solvable check changed the board";
+
+    EXPECT_TRUE(s1.undo()) << "Undo failed";
+    EXPECT_TRUE(s1.place(blank, wrong)) << "Wrong value that is still possible not placed";
+    EXPECT_FALSE(s1.isSolvable()) << "Unique puzzle solvable after a wrong move";
+    EXPECT_TRUE(s1.undo()) << "Undo failed";
+    EXPECT_FALSE(s1.undo()) << "Undo with no moves left succeeded";
+    EXPECT_EQ(s1.getBoard().cells, start.cells) << "Undo did not restore the squares";
+    EXPECT_EQ(s1.getBoard().possibles, start.possibles) << "Undo did not restore the possibles";
+    EXPECT_TRUE(s1.isSolvable()) << "Not solvable after undoing the wrong move";
+
+    //Counting works on top of the moves and leaves them in place
+    s1.place(blank, right);
+    EXPECT_EQ(s1.countSolutions(2), 1) << "Count after a move not 1";
+    EXPECT_EQ(s1.getMoveCount(), 1) << "Count dropped the move";
+    EXPECT_TRUE(s1.solve()) << "Solve after a move failed";
+    EXPECT_EQ(s1.getMoveCount(), 0) << "Moves kept after solving";
+}
+
+TEST(SudokuMovesTest, DeadSquare){
+    ifstream blank;
+    blank.open("sudoku-test-blank.txt");
+    ASSERT_TRUE(blank.is_open()) << "Failed to open sudoku-test-blank.txt";
+    Sudoku s1(blank);
+
+    //1 to 8 across the top row leaves 9 as the only possible for the last square
+    for (uint8_t val = 1; val < number_of_element_values; ++val){
+        ASSERT_TRUE(s1.place(val - 1, val)) << "Failed to place " << int(val);
+    }
+    EXPECT_EQ(s1.candidates(number_of_element_values - 1).size(), 1) << "Last square in the row not down to one possible";
+    ASSERT_TRUE(s1.place(2*number_of_element_values - 1, 9)) << "Failed to place 9 below the last square";
+    EXPECT_TRUE(s1.candidates(number_of_element_values - 1).empty()) << "Last square in the row still has a possible";
+    EXPECT_FALSE(s1.isSolvable()) << "Solvable with a square that has no possibles";
+    s1.undo();
+    EXPECT_TRUE(s1.isSolvable()) << "Not solvable after undoing the move";
+    EXPECT_EQ(s1.getMoveCount(), number_of_element_values - 1) << "Move count wrong after undo";
+}
+
+TEST(SudokuGradeTest, Grade){
+    ifstream input;
+    input.open("sudoku-test1.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test1.txt";
+    Sudoku s1(input);
+    Board before = s1.getBoard();
+    EXPECT_EQ(s1.grade(), EASY) << "Singles puzzle not graded easy";
+    EXPECT_EQ(s1.getBoard().cells, before.cells) << "Grading changed the grid";
+
+    //Needs guessing
+    Sudoku s2;
+    s2.load("-----4597-9---6-----7--5---7--4---5---3-2--14-4---97-365---3--1--8---3---1-9-----");
+    EXPECT_EQ(s2.grade(), EXPERT) << "Puzzle that needs guessing not graded expert";
+
+    ifstream unsolvable;
+    unsolvable.open("sudoku-test-unsolvable.txt");
+    ASSERT_TRUE(unsolvable.is_open()) << "Failed to open sudoku-test-unsolvable.txt";
+    Sudoku s3(unsolvable);
+    EXPECT_EQ(s3.grade(), EXPERT) << "Unsolvable puzzle not graded expert";
+}
+
+TEST(SudokuStatsTest, Stats){
+    if constexpr (!solve_stats_enabled){
+        GTEST_SKIP() << "Built with SUDOKU_SOLVE_STATS=0";
+    }
+    ifstream input;
+    input.open("sudoku-test-too-large.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test-too-large.txt";
+    Sudoku hybrid(input, HYBRID);
+    EXPECT_EQ(hybrid.getStats().nodes, 0) << "Nodes counted before solving";
+    EXPECT_GT(hybrid.getStats().parseSeconds, 0) << "Parse time not recorded";
+
+    ASSERT_TRUE(hybrid.solve()) << "Hybrid solve not TRUE";
+    const SolveStats& stats = hybrid.getStats();
+    EXPECT_EQ(stats.nodes, hybrid.getSteps()) << "Hybrid nodes not the same as steps";
+    //Only nodes are undone, so every node off the solved path is a backtrack and that path is at most maxDepth long
+    EXPECT_LT(stats.backtracks, stats.nodes) << "More backtracks than nodes";
+    EXPECT_GE(stats.backtracks, stats.nodes - 1 - stats.maxDepth) << "Undone nodes not all counted as backtracks";
+    EXPECT_GT(stats.maxDepth, 0) << "Hybrid solve made no guesses";
+    EXPECT_GT(stats.deductions[NAKED_SINGLE] + stats.deductions[HIDDEN_SINGLE], 0) << "No singles counted";
+    EXPECT_GT(stats.eliminations, 0) << "No eliminations counted";
+    EXPECT_GT(stats.propagateSeconds, 0) << "Propagation time not recorded";
+    EXPECT_GT(stats.searchSeconds, 0) << "Search time not recorded";
+
+    input.clear();
+    input.seekg(0);
+    Sudoku backtrack(input, BACKTRACK);
+    ASSERT_TRUE(backtrack.solve()) << "Backtrack solve not TRUE";
+    EXPECT_EQ(backtrack.getStats().nodes, backtrack.getSteps()) << "Backtrack nodes not the same as steps";
+    EXPECT_EQ(backtrack.getStats().backtracks, backtrack.getSteps() - 1 - backtrack.getStats().maxDepth) << "Every node but the solved path should be undone";
+
+    //A wrong guess added to a hard puzzle, it takes a search to find there is no solution and every node but the first is undone
+    for (SolveMethod method : {BACKTRACK, HYBRID, DLX}){
+        Sudoku unsolvable;
+        unsolvable.setSolverType(method);
+        ASSERT_TRUE(unsolvable.load("-----459789---6-----7--5---7--4---5---3-2--14-4---97-365---3--1--8---3---1-9-----"))
+            << "Puzzle with no solution not logical";
+        EXPECT_FALSE(unsolvable.solve()) << "Puzzle with no solution solved with method " << method;
+        EXPECT_GT(unsolvable.getStats().nodes, 1) << "No search with method " << method;
+        EXPECT_EQ(unsolvable.getStats().backtracks, unsolvable.getStats().nodes - 1) << "Backtracks not every undone node with method " << method;
+    }
+
+    //Rules only deduce, each deduction is one step
+    ifstream easy;
+    easy.open("sudoku-test1.txt");
+    ASSERT_TRUE(easy.is_open()) << "Failed to open sudoku-test1.txt";
+    Sudoku rules(easy, RULES);
+    ASSERT_TRUE(rules.solve()) << "Rules solve not TRUE on beginner puzzle";
+    uint64_t deductions = 0;
+    for (uint64_t count : rules.getStats().deductions){
+        deductions += count;
+    }
+    EXPECT_EQ(deductions, rules.getSteps()) << "Rules deductions not the same as steps";
+    EXPECT_EQ(rules.getStats().nodes, 0) << "Rules counted search nodes";
+
+    rules.load(string(grid_size, '-'));
+    EXPECT_EQ(rules.getStats().eliminations, 0) << "Stats not reset by load";
+}
+
+//Solves the puzzle in filename with method and checks the result keeps the givens and breaks no rules
+template <int BoxSize>
+void expectSolves(const string& filename, const SolveMethod& method){
+    ifstream input;
+    input.open(filename);
+    ASSERT_TRUE(input.is_open()) << "Failed to open " << filename;
+    BasicSudoku<BoxSize> s1(input, method);
+    ASSERT_TRUE(s1.isLogical()) << filename << " not logical";
+    auto before = s1.getGrid();
+    ASSERT_TRUE(s1.solve()) << filename << " not solved with method " << method;
+    auto after = s1.getGrid();
+    for (int i = 0; i < s1.grid_size; i++){
+        EXPECT_FALSE(after[i].isBlank()) << "Square " << i << " left blank in " << filename;
+        EXPECT_TRUE(s1.checkSquare(i)) << "Square " << i << " breaks a rule in " << filename;
+        if (before[i].isGiven()){
+            EXPECT_EQ(after[i].getElement(), before[i].getElement()) << "Given " << i << " changed in " << filename;
+        }
+    }
+}
+
+TEST(SudokuSizesTest, Traits){
+    EXPECT_EQ(Sudoku4::grid_size, 16) << "4x4 grid size not 16";
+    EXPECT_EQ(Sudoku16::grid_size, 256) << "16x16 grid size not 256";
+    EXPECT_EQ(Sudoku25::peer_count, 64) << "25x25 peer count not 64";
+    EXPECT_EQ(Sudoku::peer_count, peer_count) << "9x9 peer count changed";
+    EXPECT_EQ(GridTraits<4>::valueOf('G'), 16) << "G not read as 16 on 16x16";
+    EXPECT_EQ(GridTraits<4>::valueOf('a'), 10) << "Lowercase a not read as 10 on 16x16";
+    EXPECT_EQ(GridTraits<3>::valueOf('A'), 0) << "A read as a value on 9x9";
+    EXPECT_EQ(GridTraits<5>::symbolOf(25), 'P') << "25 not written as P";
+
+    const auto& tables = peer_tables_for<4>;
+    for (int index = 0; index < Sudoku16::grid_size; index++){
+        unordered_set<int> peers(tables.all[index].begin(), tables.all[index].end());
+        EXPECT_EQ(peers.size(), Sudoku16::peer_count) << "16x16 peers of " << index << " not distinct";
+        EXPECT_EQ(peers.count(index), 0) << "16x16 square " << index << " is its own peer";
+    }
+}
+
+TEST(SudokuSizesTest, Solve){
+    for (SolveMethod method : {BACKTRACK, HYBRID, DLX}){
+        expectSolves<2>("sudoku-test4.txt", method);
+    }
+    for (SolveMethod method : {HYBRID, DLX}){
+        expectSolves<4>("sudoku-test16.txt", method);
+        expectSolves<5>("sudoku-test25.txt", method);
+    }
+
+    ifstream input;
+    input.open("sudoku-test16.txt");
+    ASSERT_TRUE(input.is_open()) << "Failed to open sudoku-test16.txt";
+    Sudoku16 s1(input);
+    EXPECT_EQ(s1.countSolutions(2), 1) << "16x16 puzzle not unique";
+    string line;
+    s1.appendLine(line);
+    EXPECT_EQ(line.substr(0, 16), "---92--15---CG4-") << "16x16 line not written with letters";
+}
+
 class SudokuTestAccessors : public ::testing::Test {
     protected:
     Sudoku s1;
@@ -299,3 +864,30 @@ TEST_F(SudokuTestAccessors, Board){
     board.push_back(Square(11));
     EXPECT_GT(board.size(), s1.getGrid().size()) << "board not larger than original after modification";
 }
+
+TEST_F(SudokuTestValidInput, GetBoard){
+    EXPECT_TRUE(is_trivially_copyable_v<Board>) << "Board not trivially copyable";
+    EXPECT_LE(sizeof(Board), 256) << "9x9 Board larger than 256 bytes";
+
+    Board board = s1.getBoard();
+    vector<Square> grid = s1.getGrid();
+    for (int i = 0; i < grid_size; i++){
+        EXPECT_EQ(board[i].getElement(), grid[i].getElement()) << "Board value differs from grid at " << i;
+        EXPECT_EQ(board[i].isGiven(), grid[i].isGiven()) << "Board given differs from grid at " << i;
+        EXPECT_EQ(board[i].getPossibles(), grid[i].getPossibles()) << "Board possibles differ from grid at " << i;
+    }
+
+    //The board is a snapshot, solving leaves it alone
+    EXPECT_TRUE(s1.solve());
+    EXPECT_TRUE(board[4].isBlank()) << "Board changed by solve";
+    EXPECT_FALSE(s1.getBoard()[4].isBlank()) << "New board not solved";
+
+    board[4].setElement(1);
+    EXPECT_EQ(board[4].getElement(), 1) << "setElement on board square did not change value";
+    board[4].setToOriginalValue();
+    EXPECT_TRUE(board[4].isBlank()) << "Blank square not reset to blank";
+    board[6].setToOriginalValue();
+    EXPECT_EQ(board[6].getElement(), 4) << "Given square reset away from its value";
+    Square square = board[6];
+    EXPECT_TRUE(square.isGiven()) << "Square copied from board lost given";
+}